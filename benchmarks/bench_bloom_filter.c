@@ -0,0 +1,89 @@
+/*
+ * Compares lookups of missing keys in a hash map without a Bloom filter in front of it, with a
+ * standard Bloom filter and with a blocked (one cache line per key) Bloom filter.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_bloom_filter.h"
+#include "strukts_hashmap.h"
+
+#define KEYS_AMOUNT 1000000
+#define FALSE_POSITIVE_RATE 0.01
+
+static void bench_misses(const char* name, StruktsHashmap* hashmap, char** missing_keys, size_t n)
+{
+    size_t found = 0;
+    uint64_t start = benchmark_now_ns();
+
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, missing_keys[i]) != NULL;
+
+    benchmark_report(name, benchmark_now_ns() - start, n);
+
+    if (found > 0)
+        printf("unexpected keys found: %zu\n", found);
+}
+
+static void bench_hits(const char* name, StruktsHashmap* hashmap, char** keys, size_t n)
+{
+    size_t found = 0;
+    uint64_t start = benchmark_now_ns();
+
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, keys[i]) != NULL;
+
+    benchmark_report(name, benchmark_now_ns() - start, n);
+
+    if (found != n)
+        printf("missing keys: %zu\n", n - found);
+}
+
+static size_t false_positives(const StruktsBloomFilter* filter, char** missing_keys, size_t n)
+{
+    size_t amount = 0;
+
+    for (size_t i = 0; i < n; i++)
+        amount += strukts_bloom_filter_might_contain(filter, missing_keys[i]);
+
+    return amount;
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+    char** missing_keys = benchmark_keys_new(n, "miss");
+    StruktsHashmap* hashmap = strukts_hashmap_build((const char* const*)keys, keys, n, 1);
+
+    benchmark_shuffle(keys, n, 42);
+
+    bench_hits("strukts_hashmap_get (hits, no filter)", hashmap, keys, n);
+    bench_misses("strukts_hashmap_get (misses, no filter)", hashmap, missing_keys, n);
+
+    strukts_hashmap_attach_bloom_filter(hashmap, n, FALSE_POSITIVE_RATE,
+                                        STRUKTS_BLOOM_FILTER_DEFAULT);
+    bench_hits("strukts_hashmap_get (hits, standard filter)", hashmap, keys, n);
+    bench_misses("strukts_hashmap_get (misses, standard filter)", hashmap, missing_keys, n);
+    printf("standard filter: %.2f%% false positives, %u hashes, %.1f bits/key\n",
+           100.0 * (double)false_positives(hashmap->bloom_filter, missing_keys, n) / (double)n,
+           hashmap->bloom_filter->hashes_amount,
+           (double)hashmap->bloom_filter->bits_amount / (double)n);
+
+    strukts_hashmap_attach_bloom_filter(hashmap, n, FALSE_POSITIVE_RATE,
+                                        STRUKTS_BLOOM_FILTER_BLOCKED);
+    bench_hits("strukts_hashmap_get (hits, blocked filter)", hashmap, keys, n);
+    bench_misses("strukts_hashmap_get (misses, blocked filter)", hashmap, missing_keys, n);
+    printf("blocked filter: %.2f%% false positives, %u hashes, %.1f bits/key\n",
+           100.0 * (double)false_positives(hashmap->bloom_filter, missing_keys, n) / (double)n,
+           hashmap->bloom_filter->hashes_amount,
+           (double)hashmap->bloom_filter->bits_amount / (double)n);
+
+    strukts_hashmap_free(hashmap);
+    benchmark_keys_free(keys, n);
+    benchmark_keys_free(missing_keys, n);
+
+    return 0;
+}
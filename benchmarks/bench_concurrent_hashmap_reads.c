@@ -0,0 +1,71 @@
+/*
+ * Measures the read throughput of the concurrent (sharded) hash map with 1, 2, 4, ... threads up to
+ * the amount of online cores, which should scale nearly linearly as readers share read locks.
+ */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_concurrent_hashmap.h"
+
+#define KEYS_AMOUNT 1000000
+#define READS_PER_THREAD 4000000
+
+typedef struct {
+    StruktsConcurrentHashmap* hashmap;
+    char** keys;
+    size_t keys_amount;
+    uint64_t seed;
+    size_t found;
+} BenchmarkReader;
+
+static void* benchmark_reader(void* arg)
+{
+    BenchmarkReader* reader = (BenchmarkReader*)arg;
+    uint64_t state = reader->seed;
+
+    for (size_t i = 0; i < READS_PER_THREAD; i++) {
+        char* key = reader->keys[benchmark_random(&state) % reader->keys_amount];
+        reader->found += strukts_concurrent_hashmap_get(reader->hashmap, key) != NULL;
+    }
+
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    char** keys = benchmark_keys_new(n, "hit");
+    StruktsConcurrentHashmap* hashmap = strukts_concurrent_hashmap_new(64, STRUKTS_HASHMAP_ARENA);
+
+    for (size_t i = 0; i < n; i++)
+        strukts_concurrent_hashmap_upsert(hashmap, keys[i], keys[i]);
+
+    for (long threads_amount = 1; threads_amount <= cores; threads_amount *= 2) {
+        pthread_t threads[threads_amount];
+        BenchmarkReader readers[threads_amount];
+        uint64_t start = benchmark_now_ns();
+
+        for (long t = 0; t < threads_amount; t++) {
+            readers[t] = (BenchmarkReader){hashmap, keys, n, (uint64_t)t + 1, 0};
+            pthread_create(&threads[t], NULL, benchmark_reader, &readers[t]);
+        }
+
+        for (long t = 0; t < threads_amount; t++)
+            pthread_join(threads[t], NULL);
+
+        double seconds = (double)(benchmark_now_ns() - start) / 1e9;
+        double reads = (double)threads_amount * READS_PER_THREAD;
+
+        printf("%2ld threads: %8.2f million reads/s\n", threads_amount, reads / seconds / 1e6);
+    }
+
+    strukts_concurrent_hashmap_free(hashmap);
+    benchmark_keys_free(keys, n);
+
+    return 0;
+}
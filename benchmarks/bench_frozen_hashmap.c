@@ -0,0 +1,70 @@
+/*
+ * Compares lookups and memory of the frozen hash map (minimal perfect hashing over a dense array)
+ * against the separate chaining hash map, built with the same static set of keys.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_frozen_hashmap.h"
+#include "strukts_hashmap.h"
+#include "strukts_perfect_hash.h"
+
+#define KEYS_AMOUNT 1000000
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+    char** missing_keys = benchmark_keys_new(n, "miss");
+    size_t found = 0;
+    uint64_t start;
+
+    start = benchmark_now_ns();
+    StruktsHashmap* hashmap = strukts_hashmap_build((const char* const*)keys, keys, n, 1);
+    benchmark_report("strukts_hashmap_build", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    StruktsFrozenHashmap* frozen = strukts_frozen_hashmap_new((const char* const*)keys, keys, n);
+    benchmark_report("strukts_frozen_hashmap_new", benchmark_now_ns() - start, n);
+
+    benchmark_shuffle(keys, n, 42);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, keys[i]) != NULL;
+    benchmark_report("strukts_hashmap_get (hits)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_frozen_hashmap_get(frozen, keys[i]) != NULL;
+    benchmark_report("strukts_frozen_hashmap_get (hits)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, missing_keys[i]) != NULL;
+    benchmark_report("strukts_hashmap_get (misses)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_frozen_hashmap_get(frozen, missing_keys[i]) != NULL;
+    benchmark_report("strukts_frozen_hashmap_get (misses)", benchmark_now_ns() - start, n);
+
+    /* memory per key, without the keys/values themselves */
+    StruktsHashmapStats stats = strukts_hashmap_stats(hashmap);
+    double perfect_hash_bits = strukts_perfect_hash_bits_per_key(frozen->perfect_hash);
+
+    printf("keys found: %zu\n", found);
+    printf("hash map: %.1f bytes/key\n", (double)stats.allocated_bytes / (double)n);
+    printf("frozen hash map: %.1f bytes/key (perfect hash: %.2f bits/key, %zu levels)\n",
+           (double)sizeof(StruktsFrozenHashmapEntry) + perfect_hash_bits / 8, perfect_hash_bits,
+           frozen->perfect_hash->levels_amount);
+
+    strukts_hashmap_free(hashmap);
+    strukts_frozen_hashmap_free(frozen);
+    benchmark_keys_free(keys, n);
+    benchmark_keys_free(missing_keys, n);
+
+    return 0;
+}
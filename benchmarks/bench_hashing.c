@@ -0,0 +1,187 @@
+/*
+ * Compares the 32-bit (x86) and 128-bit (x64) murmur3 variants on keys of several lengths, hash
+ * map lookups of long keys hashed by each of them and the hashing of fragmented keys (copied into
+ * a contiguous buffer first vs streamed from their iovec fragments) and the batch hashing of
+ * short fixed-length keys on each instruction set (scalar, AVX2 and AVX-512).
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashing.h"
+#include "strukts_hashmap.h"
+
+#define HASHES_BYTES (256 * 1024 * 1024)
+#define LONG_KEYS_AMOUNT 100000
+#define LONG_KEY_LEN 1024
+#define FRAGMENT_LEN 100 /* not a multiple of 4: every fragment leaves a partial block */
+#define FRAGMENTS_AMOUNT ((LONG_KEY_LEN + FRAGMENT_LEN - 1) / FRAGMENT_LEN)
+#define SHORT_KEYS_AMOUNT 1000000
+#define SHORT_KEY_LEN 16
+#define SHORT_KEYS_ROUNDS 10
+
+static void bench_key_len(const uint8_t* buffer, size_t key_len)
+{
+    const size_t n = HASHES_BYTES / key_len;
+    uint64_t sum = 0;
+    uint64_t start;
+    char name[64];
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        sum += strukts_murmur3_hash(buffer + (i & 63), key_len, 0);
+    snprintf(name, sizeof(name), "strukts_murmur3_hash (%zu bytes)", key_len);
+    benchmark_report(name, benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t hash[2];
+
+        strukts_murmur3_hash_x64_128(buffer + (i & 63), key_len, 0, hash);
+        sum += hash[0];
+    }
+    snprintf(name, sizeof(name), "strukts_murmur3_hash_x64_128 (%zu bytes)", key_len);
+    benchmark_report(name, benchmark_now_ns() - start, n);
+
+    printf("hash sum: %llu\n", (unsigned long long)sum);
+}
+
+static void bench_long_keys(const char* name, unsigned int flags, char** keys, size_t n)
+{
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_flags(flags);
+    size_t found = 0;
+
+    for (size_t i = 0; i < n; i++)
+        strukts_hashmap_add(hashmap, keys[i], keys[i]);
+
+    uint64_t start = benchmark_now_ns();
+
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, keys[i]) != NULL;
+
+    benchmark_report(name, benchmark_now_ns() - start, n);
+
+    if (found != n)
+        printf("missing keys: %zu\n", n - found);
+
+    strukts_hashmap_free(hashmap);
+}
+
+static void bench_fragments(const uint8_t* buffer)
+{
+    const size_t n = HASHES_BYTES / LONG_KEY_LEN;
+    struct iovec fragments[FRAGMENTS_AMOUNT];
+    uint8_t contiguous[LONG_KEY_LEN];
+    uint64_t sum = 0;
+    uint64_t start;
+
+    for (size_t i = 0; i < FRAGMENTS_AMOUNT; i++) {
+        const size_t offset = i * FRAGMENT_LEN;
+
+        fragments[i].iov_base = (void*)(buffer + offset);
+        fragments[i].iov_len =
+            LONG_KEY_LEN - offset < FRAGMENT_LEN ? LONG_KEY_LEN - offset : FRAGMENT_LEN;
+    }
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        size_t contiguous_len = 0;
+
+        for (size_t j = 0; j < FRAGMENTS_AMOUNT; j++) {
+            memcpy(contiguous + contiguous_len, fragments[j].iov_base, fragments[j].iov_len);
+            contiguous_len += fragments[j].iov_len;
+        }
+
+        sum += strukts_murmur3_hash(contiguous, contiguous_len, (uint32_t)i);
+    }
+    benchmark_report("memcpy + strukts_murmur3_hash (1 KB)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        sum -= strukts_murmur3_hash_iov(fragments, FRAGMENTS_AMOUNT, (uint32_t)i);
+    benchmark_report("strukts_murmur3_hash_iov (1 KB)", benchmark_now_ns() - start, n);
+
+    /* both hashes are the same: the sum must be back to 0 */
+    printf("hash sum: %llu\n", (unsigned long long)sum);
+}
+
+static void bench_many(const uint8_t* const* keys, size_t key_len, uint32_t* hashes)
+{
+    const char* names[3] = {"strukts_murmur3_hash_many (scalar)",
+                            "strukts_murmur3_hash_many (AVX2)",
+                            "strukts_murmur3_hash_many (AVX-512)"};
+    uint64_t sum = 0;
+
+    for (unsigned int level = STRUKTS_MURMUR3_SCALAR; level <= strukts_murmur3_simd_level();
+         level++) {
+        uint64_t start = benchmark_now_ns();
+
+        for (size_t round = 0; round < SHORT_KEYS_ROUNDS; round++)
+            strukts_murmur3_hash_many_with_level(keys, key_len, SHORT_KEYS_AMOUNT, (uint32_t)round,
+                                                 hashes, level);
+
+        benchmark_report(names[level], benchmark_now_ns() - start,
+                         SHORT_KEYS_ROUNDS * SHORT_KEYS_AMOUNT);
+
+        for (size_t i = 0; i < SHORT_KEYS_AMOUNT; i++)
+            sum += hashes[i];
+    }
+
+    printf("hash sum: %llu\n", (unsigned long long)sum);
+}
+
+int main(void)
+{
+    uint8_t* buffer = (uint8_t*)malloc(LONG_KEY_LEN + 64);
+    char** keys = (char**)malloc(LONG_KEYS_AMOUNT * sizeof(char*));
+    const size_t key_lens[4] = {8, 64, 256, LONG_KEY_LEN};
+
+    for (size_t i = 0; i < LONG_KEY_LEN + 64; i++)
+        buffer[i] = (uint8_t)(i * 31 + 7);
+
+    for (size_t i = 0; i < 4; i++)
+        bench_key_len(buffer, key_lens[i]);
+
+    bench_fragments(buffer);
+
+    /* short fixed-length keys of a batch ingestion (such as 16-byte ids), one after the other */
+    uint8_t* short_keys = (uint8_t*)malloc(SHORT_KEYS_AMOUNT * SHORT_KEY_LEN);
+    const uint8_t** short_key_pointers =
+        (const uint8_t**)malloc(SHORT_KEYS_AMOUNT * sizeof(uint8_t*));
+    uint32_t* hashes = (uint32_t*)malloc(SHORT_KEYS_AMOUNT * sizeof(uint32_t));
+
+    memset(hashes, 0, SHORT_KEYS_AMOUNT * sizeof(uint32_t)); /* no page faults while measuring */
+
+    for (size_t i = 0; i < SHORT_KEYS_AMOUNT * SHORT_KEY_LEN; i++)
+        short_keys[i] = (uint8_t)(i * 131 + 17);
+
+    for (size_t i = 0; i < SHORT_KEYS_AMOUNT; i++)
+        short_key_pointers[i] = short_keys + i * SHORT_KEY_LEN;
+
+    bench_many(short_key_pointers, SHORT_KEY_LEN, hashes);
+
+    free(short_keys);
+    free(short_key_pointers);
+    free(hashes);
+
+    /* long keys (such as URLs with query strings) that only differ at their end */
+    for (size_t i = 0; i < LONG_KEYS_AMOUNT; i++) {
+        keys[i] = (char*)malloc(LONG_KEY_LEN + 1);
+        memset(keys[i], 'k', LONG_KEY_LEN);
+        snprintf(keys[i] + LONG_KEY_LEN - 16, 17, "%016zu", i);
+    }
+
+    benchmark_shuffle(keys, LONG_KEYS_AMOUNT, 42);
+
+    bench_long_keys("strukts_hashmap_get (1 KB keys)", STRUKTS_HASHMAP_DEFAULT, keys,
+                    LONG_KEYS_AMOUNT);
+    bench_long_keys("strukts_hashmap_get (1 KB keys, murmur3 128)", STRUKTS_HASHMAP_MURMUR3_128,
+                    keys, LONG_KEYS_AMOUNT);
+
+    benchmark_keys_free(keys, LONG_KEYS_AMOUNT);
+    free(buffer);
+
+    return 0;
+}
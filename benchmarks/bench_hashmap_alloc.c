@@ -0,0 +1,56 @@
+/*
+ * Compares building and deallocating a hash map whose entries are allocated one by one (malloc)
+ * against a hash map whose entries are allocated from arena slabs.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashmap.h"
+
+#define KEYS_AMOUNT 4000000
+
+typedef struct {
+    const char* name;
+    char** keys;
+    size_t n;
+    unsigned int flags;
+} AllocRun;
+
+static void benchmark_build_and_free(void* arg)
+{
+    const AllocRun* run = (const AllocRun*)arg;
+    uint64_t start = benchmark_now_ns();
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_flags(run->flags);
+
+    for (size_t i = 0; i < run->n; i++)
+        strukts_hashmap_add(hashmap, run->keys[i], run->keys[i]);
+
+    uint64_t built = benchmark_now_ns();
+
+    strukts_hashmap_free(hashmap);
+
+    printf("%-40s build: %8.2f ms    free: %8.2f ms\n", run->name, (double)(built - start) / 1e6,
+           (double)(benchmark_now_ns() - built) / 1e6);
+}
+
+static void benchmark_alloc_process(const char* name, char** keys, size_t n, unsigned int flags)
+{
+    AllocRun run = {name, keys, n, flags};
+
+    benchmark_process(benchmark_build_and_free, &run);
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+
+    benchmark_alloc_process("strukts_hashmap (malloc per entry)", keys, n, STRUKTS_HASHMAP_DEFAULT);
+    benchmark_alloc_process("strukts_hashmap (arena slabs)", keys, n, STRUKTS_HASHMAP_ARENA);
+
+    benchmark_keys_free(keys, n);
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Compares loading many keys into a hash map that starts at its initial capacity (and doubles
+ * along the way) against a pre-sized hash map and against bulk builds (single and multithreaded).
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashmap.h"
+
+#define KEYS_AMOUNT 4000000
+
+typedef enum { LOAD_ADD, LOAD_PRESIZED_ADD, LOAD_BUILD } LoadMode;
+
+typedef struct {
+    const char* name;
+    char** keys;
+    size_t n;
+    LoadMode mode;
+    size_t threads;
+} LoadRun;
+
+static void benchmark_load(void* arg)
+{
+    const LoadRun* run = (const LoadRun*)arg;
+    char** keys = run->keys;
+    size_t n = run->n;
+    uint64_t start = benchmark_now_ns();
+    StruktsHashmap* hashmap;
+
+    if (run->mode == LOAD_BUILD) {
+        hashmap = strukts_hashmap_build((const char* const*)keys, keys, n, run->threads);
+    } else {
+        hashmap = run->mode == LOAD_ADD ? strukts_hashmap_new()
+                                        : strukts_hashmap_new_with_capacity(n);
+
+        for (size_t i = 0; i < n; i++)
+            strukts_hashmap_add(hashmap, keys[i], keys[i]);
+    }
+
+    benchmark_report(run->name, benchmark_now_ns() - start, n);
+    strukts_hashmap_free(hashmap);
+}
+
+static void benchmark_load_process(const char* name, char** keys, size_t n, LoadMode mode,
+                                   size_t threads)
+{
+    LoadRun run = {name, keys, n, mode, threads};
+
+    benchmark_process(benchmark_load, &run);
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    size_t cores = (size_t)sysconf(_SC_NPROCESSORS_ONLN);
+    char** keys = benchmark_keys_new(n, "hit");
+    char name[64];
+
+    benchmark_load_process("strukts_hashmap_add (doubling)", keys, n, LOAD_ADD, 1);
+    benchmark_load_process("strukts_hashmap_add (presized)", keys, n, LOAD_PRESIZED_ADD, 1);
+    benchmark_load_process("strukts_hashmap_build (1 thread)", keys, n, LOAD_BUILD, 1);
+
+    snprintf(name, sizeof(name), "strukts_hashmap_build (%zu threads)", cores);
+    benchmark_load_process(name, keys, n, LOAD_BUILD, cores);
+
+    benchmark_keys_free(keys, n);
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * Compares a loop of single strukts_hashmap_get calls against batched strukts_hashmap_get_many
+ * calls (which prefetch buckets and interleave chain walks) on a table much bigger than the CPU
+ * caches.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashmap.h"
+
+#define KEYS_AMOUNT 4000000
+#define BATCH_SIZE 128
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+    char* values[BATCH_SIZE];
+    size_t found = 0;
+    uint64_t start;
+
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_ARENA);
+
+    for (size_t i = 0; i < n; i++)
+        strukts_hashmap_add(hashmap, keys[i], keys[i]);
+
+    /* lookups in a random order so that the hardware prefetcher can't help */
+    benchmark_shuffle(keys, n, 42);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, keys[i]) != NULL;
+    benchmark_report("strukts_hashmap_get (loop)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i + BATCH_SIZE <= n; i += BATCH_SIZE) {
+        const char* const* batch_keys = (const char* const*)keys + i;
+
+        found += strukts_hashmap_get_many(hashmap, batch_keys, BATCH_SIZE, values);
+    }
+    benchmark_report("strukts_hashmap_get_many (batches of 128)", benchmark_now_ns() - start, n);
+
+    printf("keys found: %zu\n", found);
+
+    strukts_hashmap_free(hashmap);
+    benchmark_keys_free(keys, n);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Compares lookups (hits and misses) of the separate chaining hash map against the open
+ * addressing flat and Robin Hood hash maps on tables much bigger than the CPU caches. Cache misses
+ * can be inspected by running this program with: perf stat -e cache-misses ./bench_hashmap_lookups
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_flathashmap.h"
+#include "strukts_hashmap.h"
+#include "strukts_robinhood_hashmap.h"
+
+#define KEYS_AMOUNT 1000000
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+    char** missing_keys = benchmark_keys_new(n, "miss");
+    size_t found = 0;
+    uint64_t start;
+
+    StruktsHashmap* hashmap = strukts_hashmap_new();
+    StruktsFlatHashmap* flathashmap = strukts_flathashmap_new();
+    StruktsRobinHoodHashmap* robinhood = strukts_robinhood_hashmap_new();
+
+    for (size_t i = 0; i < n; i++) {
+        strukts_hashmap_add(hashmap, keys[i], keys[i]);
+        strukts_flathashmap_add(flathashmap, keys[i], keys[i]);
+        strukts_robinhood_hashmap_upsert(robinhood, keys[i], keys[i]);
+    }
+
+    /* lookups in a random order so that the hardware prefetcher can't help */
+    benchmark_shuffle(keys, n, 42);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, keys[i]) != NULL;
+    benchmark_report("strukts_hashmap_get (hits)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_flathashmap_get(flathashmap, keys[i]) != NULL;
+    benchmark_report("strukts_flathashmap_get (hits)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_robinhood_hashmap_get(robinhood, keys[i]) != NULL;
+    benchmark_report("strukts_robinhood_hashmap_get (hits)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, missing_keys[i]) != NULL;
+    benchmark_report("strukts_hashmap_get (misses)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_flathashmap_get(flathashmap, missing_keys[i]) != NULL;
+    benchmark_report("strukts_flathashmap_get (misses)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_robinhood_hashmap_get(robinhood, missing_keys[i]) != NULL;
+    benchmark_report("strukts_robinhood_hashmap_get (misses)", benchmark_now_ns() - start, n);
+
+    StruktsRobinHoodHashmapProbeStats stats = strukts_robinhood_hashmap_probe_stats(robinhood);
+
+    printf("keys found: %zu\n", found);
+    printf("robin hood load factor: %.3f, max probe length: %zu, mean probe length: %.3f\n",
+           (double)robinhood->size / (double)robinhood->capacity, stats.max_probe_length,
+           stats.mean_probe_length);
+
+    strukts_hashmap_free(hashmap);
+    strukts_flathashmap_free(flathashmap);
+    strukts_robinhood_hashmap_free(robinhood);
+    benchmark_keys_free(keys, n);
+    benchmark_keys_free(missing_keys, n);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Compares the worst single strukts_hashmap_add latency of rehashing all keys at once against
+ * incremental rehashing, which spreads the rehashing work over later operations.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashmap.h"
+
+#define KEYS_AMOUNT 4000000
+
+typedef struct {
+    const char* name;
+    char** keys;
+    size_t n;
+    unsigned int flags;
+} AddsRun;
+
+static void benchmark_adds(void* arg)
+{
+    const AddsRun* run = (const AddsRun*)arg;
+    char** keys = run->keys;
+    size_t n = run->n;
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_flags(run->flags);
+    uint64_t worst_ns = 0;
+    uint64_t start = benchmark_now_ns();
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t add_start = benchmark_now_ns();
+
+        strukts_hashmap_add(hashmap, keys[i], keys[i]);
+
+        uint64_t add_ns = benchmark_now_ns() - add_start;
+
+        if (add_ns > worst_ns)
+            worst_ns = add_ns;
+    }
+
+    benchmark_report(run->name, benchmark_now_ns() - start, n);
+    printf("%-48s %10.3f ms\n", "  worst single add", (double)worst_ns / 1e6);
+
+    strukts_hashmap_free(hashmap);
+}
+
+static void benchmark_adds_process(const char* name, char** keys, size_t n, unsigned int flags)
+{
+    AddsRun run = {name, keys, n, flags};
+
+    benchmark_process(benchmark_adds, &run);
+}
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+
+    benchmark_adds_process("strukts_hashmap_add (rehash at once)", keys, n,
+                           STRUKTS_HASHMAP_DEFAULT);
+    benchmark_adds_process("strukts_hashmap_add (incremental rehash)", keys, n,
+                           STRUKTS_HASHMAP_INCREMENTAL_REHASH);
+
+    benchmark_keys_free(keys, n);
+
+    return 0;
+}
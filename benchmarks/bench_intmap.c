@@ -0,0 +1,68 @@
+/*
+ * Compares lookups of 64-bit ids in the integer map against the string path: formatting the ids
+ * as strings (sprintf) and looking them up in the string keyed hash map.
+ */
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashmap.h"
+#include "strukts_intmap.h"
+
+#define KEYS_AMOUNT 1000000
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    uint64_t* ids = (uint64_t*)malloc(n * sizeof(uint64_t));
+    char** id_strings = (char**)malloc(n * sizeof(char*));
+    char key[32];
+    uint64_t state = 42;
+    size_t found = 0;
+    uint64_t start;
+
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_capacity(n);
+    StruktsIntmap* intmap = strukts_intmap_new();
+
+    for (size_t i = 0; i < n; i++) {
+        ids[i] = benchmark_random(&state) | 1; /* random non-zero 64-bit ids */
+        id_strings[i] = (char*)malloc(21);
+        snprintf(id_strings[i], 21, "%" PRIu64, ids[i]);
+
+        strukts_hashmap_add(hashmap, id_strings[i], id_strings[i]);
+        strukts_intmap_upsert(intmap, ids[i], id_strings[i]);
+    }
+
+    /* the string path formats every id before looking it up */
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++) {
+        snprintf(key, sizeof(key), "%" PRIu64, ids[i]);
+        found += strukts_hashmap_get(hashmap, key) != NULL;
+    }
+    benchmark_report("sprintf + strukts_hashmap_get", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, id_strings[i]) != NULL;
+    benchmark_report("strukts_hashmap_get (preformatted)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_intmap_get(intmap, ids[i]) != NULL;
+    benchmark_report("strukts_intmap_get", benchmark_now_ns() - start, n);
+
+    printf("keys found: %zu\n", found);
+
+    strukts_hashmap_free(hashmap);
+    strukts_intmap_free(intmap);
+
+    for (size_t i = 0; i < n; i++)
+        free(id_strings[i]);
+
+    free(id_strings);
+    free(ids);
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * Compares the cold start of a lookup table: rebuilding a hash map from its source keys against
+ * opening a file written by strukts_mapped_hashmap_write, and then compares their lookups. Drop
+ * the page cache beforehand (echo 3 > /proc/sys/vm/drop_caches) to measure lookups of cold pages.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_hashmap.h"
+#include "strukts_mapped_hashmap.h"
+
+#define KEYS_AMOUNT 1000000
+#define MAPPED_FILE "bench_mapped_hashmap.bin"
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "hit");
+    size_t found = 0;
+    uint64_t start;
+
+    /* cold start 1: the hash map is rebuilt from the source keys */
+    start = benchmark_now_ns();
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_capacity(n);
+
+    for (size_t i = 0; i < n; i++)
+        strukts_hashmap_add(hashmap, keys[i], keys[i]);
+
+    printf("%-48s %10.2f ms\n", "rebuild hash map", (double)(benchmark_now_ns() - start) / 1e6);
+
+    start = benchmark_now_ns();
+    strukts_mapped_hashmap_write(hashmap, MAPPED_FILE);
+    printf("%-48s %10.2f ms\n", "strukts_mapped_hashmap_write",
+           (double)(benchmark_now_ns() - start) / 1e6);
+
+    /* cold start 2: the file is just mapped */
+    start = benchmark_now_ns();
+    StruktsMappedHashmap* mapped = strukts_mapped_hashmap_open(MAPPED_FILE);
+    printf("%-48s %10.2f ms\n", "strukts_mapped_hashmap_open",
+           (double)(benchmark_now_ns() - start) / 1e6);
+
+    benchmark_shuffle(keys, n, 42);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_mapped_hashmap_get(mapped, keys[i]) != NULL;
+    benchmark_report("strukts_mapped_hashmap_get (first touch)", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_mapped_hashmap_get(mapped, keys[i]) != NULL;
+    benchmark_report("strukts_mapped_hashmap_get", benchmark_now_ns() - start, n);
+
+    start = benchmark_now_ns();
+    for (size_t i = 0; i < n; i++)
+        found += strukts_hashmap_get(hashmap, keys[i]) != NULL;
+    benchmark_report("strukts_hashmap_get", benchmark_now_ns() - start, n);
+
+    printf("keys found: %zu\n", found);
+
+    strukts_mapped_hashmap_close(mapped);
+    strukts_hashmap_free(hashmap);
+    benchmark_keys_free(keys, n);
+    remove(MAPPED_FILE);
+
+    return 0;
+}
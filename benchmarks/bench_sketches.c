@@ -0,0 +1,74 @@
+/*
+ * Compares the throughput of HyperLogLog and Count-Min sketches against hashing the keys alone
+ * and their memory against counting distinct keys exactly with the hash map.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_benchmark.h"
+#include "strukts_count_min.h"
+#include "strukts_hashing.h"
+#include "strukts_hashmap.h"
+#include "strukts_hyperloglog.h"
+
+#define KEYS_AMOUNT 1000000
+#define PASSES 4
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : KEYS_AMOUNT;
+    char** keys = benchmark_keys_new(n, "event");
+    const char* const* stream = (const char* const*)keys;
+    StruktsHyperLogLog* hll = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION);
+    StruktsCountMin* sketch = strukts_count_min_new(0.01, 0.01);
+    StruktsHashmap* hashmap = strukts_hashmap_new();
+    uint64_t hashes = 0;
+    uint64_t start;
+
+    /* baseline: the two murmur3 hashes that both sketches compute per key */
+    start = benchmark_now_ns();
+    for (size_t pass = 0; pass < PASSES; pass++)
+        for (size_t i = 0; i < n; i++) {
+            const size_t key_len = strlen(stream[i]);
+
+            hashes += strukts_murmur3_hash((const uint8_t*)stream[i], key_len, 0);
+            hashes += strukts_murmur3_hash((const uint8_t*)stream[i], key_len, 0x9747b28cu);
+        }
+    benchmark_report("strukts_murmur3_hash (x2)", benchmark_now_ns() - start, PASSES * n);
+
+    start = benchmark_now_ns();
+    for (size_t pass = 0; pass < PASSES; pass++)
+        strukts_hyperloglog_add_many(hll, stream, n);
+    benchmark_report("strukts_hyperloglog_add_many", benchmark_now_ns() - start, PASSES * n);
+
+    start = benchmark_now_ns();
+    for (size_t pass = 0; pass < PASSES; pass++)
+        strukts_count_min_add_many(sketch, stream, n);
+    benchmark_report("strukts_count_min_add_many", benchmark_now_ns() - start, PASSES * n);
+
+    start = benchmark_now_ns();
+    for (size_t pass = 0; pass < PASSES; pass++)
+        for (size_t i = 0; i < n; i++)
+            strukts_hashmap_upsert(hashmap, stream[i], keys[i]);
+    benchmark_report("strukts_hashmap_upsert (exact)", benchmark_now_ns() - start, PASSES * n);
+
+    StruktsHashmapStats stats = strukts_hashmap_stats(hashmap);
+
+    printf("hash sum: %llu\n", (unsigned long long)hashes);
+    printf("distinct keys: %zu (exact), %llu (hyperloglog)\n", stats.size,
+           (unsigned long long)strukts_hyperloglog_count(hll));
+    printf("count-min estimate of a key: %u (exact: %d, error bound: %.0f)\n",
+           strukts_count_min_estimate(sketch, keys[0]), PASSES, 0.01 * (double)sketch->total);
+    printf("memory: hash map %zu bytes, hyperloglog %zu bytes, count-min %zu bytes\n",
+           stats.allocated_bytes, hll->registers_amount,
+           sketch->width * sketch->depth * sizeof(uint32_t));
+
+    strukts_hyperloglog_free(hll);
+    strukts_count_min_free(sketch);
+    strukts_hashmap_free(hashmap);
+    benchmark_keys_free(keys, n);
+
+    return 0;
+}
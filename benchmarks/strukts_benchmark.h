@@ -0,0 +1,100 @@
+/**
+ * @file strukts_benchmark.h
+ *
+ * @brief Small helpers shared by the benchmark programs: a monotonic clock, a pseudo-random
+ * number generator, a generator of string keys and a runner of benchmarks in child processes.
+ */
+
+#ifndef STRUKTS_BENCHMARK_H
+#define STRUKTS_BENCHMARK_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static inline uint64_t benchmark_now_ns()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static inline uint64_t benchmark_random(uint64_t* state)
+{
+    /* xorshift64*: good enough for shuffling benchmark inputs */
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dull;
+}
+
+static inline void benchmark_shuffle(char** keys, size_t n, uint64_t seed)
+{
+    uint64_t state = seed;
+
+    /* fewer than 2 keys are already shuffled (and n - 1 would wrap around for n == 0) */
+    if (n < 2)
+        return;
+
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = benchmark_random(&state) % (i + 1);
+        char* tmp = keys[i];
+
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+/* allocates n url-like string keys whose contents depend on a prefix (such as "hit" or "miss") */
+static inline char** benchmark_keys_new(size_t n, const char* prefix)
+{
+    char** keys = (char**)malloc(n * sizeof(char*));
+
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = (char*)malloc(64);
+        snprintf(keys[i], 64, "https://strukts.io/%s/%zu", prefix, i);
+    }
+
+    return keys;
+}
+
+static inline void benchmark_keys_free(char** keys, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        free(keys[i]);
+
+    free(keys);
+}
+
+static inline void benchmark_report(const char* name, uint64_t elapsed_ns, size_t operations)
+{
+    printf("%-48s %10.2f ns/op\n", name, (double)elapsed_ns / (double)operations);
+}
+
+/* runs benchmark(arg) in a fresh process so that one run's frees don't slow down the next run's
+ * mallocs. If no process can be forked, the benchmark runs in this process instead */
+static inline void benchmark_process(void (*benchmark)(void*), void* arg)
+{
+    pid_t pid = fork();
+
+    if (pid < 0) {
+        perror("benchmark_process: fork failed, running in the current process");
+        benchmark(arg);
+        return;
+    }
+
+    if (pid == 0) {
+        benchmark(arg);
+        exit(0);
+    }
+
+    waitpid(pid, NULL, 0);
+}
+
+#endif /* STRUKTS_BENCHMARK_H */
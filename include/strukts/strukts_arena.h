@@ -0,0 +1,97 @@
+/**
+ * @file strukts_arena.h
+ *
+ * @brief Module that contains an arena (slab) allocator for fixed-size items. To create a new
+ * arena, @see strukts_arena_new.
+ *
+ * Instead of one malloc per item, an arena allocates items from large slabs (blocks of many
+ * items), recycles released items through a free list and deallocates all of its slabs at once,
+ * which makes creating and destroying structures with many small nodes much cheaper. The items of
+ * a slab start at a cache line boundary, so items whose size is a multiple of
+ * STRUKTS_ARENA_CACHE_LINE never straddle two cache lines.
+ */
+
+#ifndef STRUKTS_ARENA_H
+#define STRUKTS_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define STRUKTS_ARENA_CACHE_LINE 64 /* slabs' items are aligned to cache lines */
+
+/**
+ * A slab of items: a header followed by slab_items items.
+ */
+typedef struct _StruktsArenaSlab StruktsArenaSlab;
+
+struct _StruktsArenaSlab {
+    StruktsArenaSlab* next; /* previously allocated slab */
+};
+
+/**
+ * Represents an arena of fixed-size items allocated from slabs.
+ */
+typedef struct _StruktsArena StruktsArena;
+
+struct _StruktsArena {
+    size_t item_size;        /* bytes per item (rounded up for alignment) */
+    size_t slab_items;       /* amount of items per slab */
+    size_t slabs_amount;     /* amount of slabs allocated so far */
+    StruktsArenaSlab* slabs; /* list of allocated slabs (newest first) */
+    void* free_list;         /* released items ready to be recycled */
+    char* next_item;         /* next never used item of the newest slab */
+    size_t remaining_items;  /* amount of never used items left in the newest slab */
+};
+
+/**
+ * Allocates a new arena whose items have item_size bytes and whose slabs hold slab_items items.
+ *
+ * @param item_size is the amount of bytes of each item.
+ * @param slab_items is the amount of items allocated at once by each slab.
+ *
+ * @return a pointer to an empty arena (no slabs are allocated until the first item is needed).
+ */
+StruktsArena* strukts_arena_new(size_t item_size, size_t slab_items);
+
+/**
+ * Deallocates all slabs of the arena at once: all items allocated by the arena become invalid.
+ *
+ * @param arena is the arena to deallocate.
+ */
+void strukts_arena_free(StruktsArena* arena);
+
+/**
+ * Allocates an item from the arena: a released item is recycled, if there's any. Otherwise, the
+ * item is taken from the newest slab (a new slab is allocated when the newest one is full).
+ *
+ * @param arena is the arena to allocate the item from.
+ *
+ * @return a pointer to an uninitialized item; NULL if a new slab could not be allocated.
+ */
+void* strukts_arena_alloc(StruktsArena* arena);
+
+/**
+ * Releases an item back to the arena's free list so that it can be recycled by later allocations.
+ *
+ * @param arena is the arena that allocated the item.
+ * @param item is the item to be released.
+ */
+void strukts_arena_release(StruktsArena* arena, void* item);
+
+/**
+ * Gets the total amount of bytes allocated by the arena's slabs.
+ *
+ * @param arena is an arena.
+ *
+ * @return the amount of bytes allocated by the arena's slabs.
+ */
+size_t strukts_arena_allocated_bytes(const StruktsArena* arena);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_ARENA_H */
@@ -0,0 +1,161 @@
+/**
+ * @file strukts_bloom_filter.h
+ *
+ * @brief Module that contains a Bloom filter implementation: a compact bit array that answers
+ * whether a key "might be" in a set (with a configurable false positive rate) or is surely not in
+ * it. To create a new empty Bloom filter, @see strukts_bloom_filter_new.
+ *
+ * Each key is hashed twice by murmur3 with two seeds and its k bit positions are derived from both
+ * hashes by double hashing (h1 + i * h2), so no more hashes are computed no matter how big k is.
+ * Bloom filters created with the STRUKTS_BLOOM_FILTER_MURMUR3_128 flag take both hashes from a
+ * single 128-bit murmur3 hash instead (its lower and upper 64 bits), which is faster on long keys.
+ *
+ * Bloom filters created with the STRUKTS_BLOOM_FILTER_BLOCKED flag split their bits into cache line
+ * sized blocks (512 bits): the first hash chooses the key's block and all k bits of the key are set
+ * in that block, so a query reads a single cache line. The price is a slightly higher false
+ * positive rate than the standard layout with the same amount of bits.
+ *
+ * A Bloom filter can be attached in front of a hash map (@see strukts_hashmap_attach_bloom_filter)
+ * so that most lookups of missing keys are answered without walking any chain.
+ */
+
+#ifndef STRUKTS_BLOOM_FILTER_H
+#define STRUKTS_BLOOM_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_BLOOM_FILTER_BLOCK_BITS 512      /* bits of a cache line sized block */
+#define STRUKTS_BLOOM_FILTER_MAX_HASHES 16       /* bits set per key at most (k) */
+#define STRUKTS_BLOOM_FILTER_SEED 0              /* same seed of the hash map's key hashes */
+#define STRUKTS_BLOOM_FILTER_ALT_SEED 0x9747b28cu /* seed of the second hash of the keys */
+
+/* Bloom filter flags: can be combined with bitwise or */
+#define STRUKTS_BLOOM_FILTER_DEFAULT 0
+#define STRUKTS_BLOOM_FILTER_BLOCKED (1u << 0)
+#define STRUKTS_BLOOM_FILTER_MURMUR3_128 (1u << 1)
+
+/**
+ * Represents a Bloom filter.
+ */
+typedef struct _StruktsBloomFilter StruktsBloomFilter;
+
+struct _StruktsBloomFilter {
+    size_t bits_amount;         /* m: always a multiple of STRUKTS_BLOOM_FILTER_BLOCK_BITS */
+    size_t blocks_amount;       /* amount of 512-bit blocks */
+    unsigned int hashes_amount; /* k: bits set per key */
+    unsigned int flags;         /* STRUKTS_BLOOM_FILTER_* flags used to create the filter */
+    size_t keys_amount;         /* amount of added keys (added again keys included) */
+    uint64_t* words;            /* cache line aligned bit array */
+    void* words_memory;         /* allocated memory that holds the aligned bit array */
+};
+
+/**
+ * Allocates a new empty Bloom filter sized for expected_keys keys at the given false positive
+ * rate: m = -n * ln(p) / ln(2)^2 bits (rounded up to whole blocks) and k = m / n * ln(2) hashes.
+ *
+ * @param expected_keys is the amount of keys expected to be added to the filter.
+ * @param false_positive_rate is the false positive rate once all keys are added, in (0, 1).
+ * @param flags is a bitwise or of STRUKTS_BLOOM_FILTER_* flags (or STRUKTS_BLOOM_FILTER_DEFAULT).
+ *
+ * @return a pointer to an empty Bloom filter; NULL if the false positive rate is not in (0, 1) or
+ * if any allocation failed.
+ */
+StruktsBloomFilter* strukts_bloom_filter_new(size_t expected_keys, double false_positive_rate,
+                                             unsigned int flags);
+
+/**
+ * Deallocates all memory previously allocated by the Bloom filter.
+ *
+ * @param filter is the Bloom filter to deallocate.
+ */
+void strukts_bloom_filter_free(StruktsBloomFilter* filter);
+
+/**
+ * Adds a key to the Bloom filter (keys can't be removed).
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param key is a pointer to a string key.
+ */
+void strukts_bloom_filter_add(StruktsBloomFilter* filter, const char* key);
+
+/**
+ * Adds a key of key_len bytes to the Bloom filter. Works just like strukts_bloom_filter_add.
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ */
+void strukts_bloom_filter_add_n(StruktsBloomFilter* filter, const void* key, size_t key_len);
+
+/**
+ * Adds a key to the Bloom filter given its two murmur3 hashes, for callers that have already hashed
+ * the key (such as a hash map whose key hashes use STRUKTS_BLOOM_FILTER_SEED). With the
+ * STRUKTS_BLOOM_FILTER_MURMUR3_128 flag, the hashes are the lower 32 bits of each half of the
+ * 128-bit murmur3 hash of the key with STRUKTS_BLOOM_FILTER_SEED.
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param hash is the murmur3 hash of the key with STRUKTS_BLOOM_FILTER_SEED.
+ * @param alt_hash is the murmur3 hash of the key with STRUKTS_BLOOM_FILTER_ALT_SEED.
+ */
+void strukts_bloom_filter_add_hashes(StruktsBloomFilter* filter, uint32_t hash, uint32_t alt_hash);
+
+/**
+ * Checks whether a key might be in the Bloom filter.
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param key is a pointer to a string key.
+ *
+ * @return false if the key was surely never added. True if it might have been added.
+ */
+bool strukts_bloom_filter_might_contain(const StruktsBloomFilter* filter, const char* key);
+
+/**
+ * Checks whether a key of key_len bytes might be in the Bloom filter. Works just like
+ * strukts_bloom_filter_might_contain.
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return false if the key was surely never added. True if it might have been added.
+ */
+bool strukts_bloom_filter_might_contain_n(const StruktsBloomFilter* filter, const void* key,
+                                          size_t key_len);
+
+/**
+ * Checks whether a key might be in the Bloom filter given its two murmur3 hashes (@see
+ * strukts_bloom_filter_add_hashes).
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param hash is the murmur3 hash of the key with STRUKTS_BLOOM_FILTER_SEED.
+ * @param alt_hash is the murmur3 hash of the key with STRUKTS_BLOOM_FILTER_ALT_SEED.
+ *
+ * @return false if the key was surely never added. True if it might have been added.
+ */
+bool strukts_bloom_filter_might_contain_hashes(const StruktsBloomFilter* filter, uint32_t hash,
+                                               uint32_t alt_hash);
+
+/**
+ * Checks whether a key might be in the Bloom filter given only its first murmur3 hash: a cheap
+ * pre-check for callers that haven't computed the second hash yet. Only the bits that the first
+ * hash picks on its own are read: the key's first bit or, when blocked, the key's whole block.
+ *
+ * @param filter is a pointer to a Bloom filter.
+ * @param hash is the murmur3 hash of the key with STRUKTS_BLOOM_FILTER_SEED.
+ *
+ * @return false if the key was surely never added. True if it might have been added (which must
+ * then be confirmed by strukts_bloom_filter_might_contain_hashes).
+ */
+bool strukts_bloom_filter_might_contain_first_hash(const StruktsBloomFilter* filter,
+                                                   uint32_t hash);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_BLOOM_FILTER_H */
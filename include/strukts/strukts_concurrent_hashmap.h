@@ -0,0 +1,120 @@
+/**
+ * @file strukts_concurrent_hashmap.h
+ *
+ * @brief Module that contains a thread-safe hash map implementation. To create a new empty
+ * concurrent hash map, @see strukts_concurrent_hashmap_new.
+ *
+ * A concurrent hash map is built from N independent shards: each shard is a separate chaining hash
+ * map (@see strukts_hashmap.h) guarded by its own reader-writer lock. A key's shard is chosen from
+ * the high bits of its murmur3 hash (shards' buckets use the low bits), so threads working on
+ * different shards never contend, lookups on the same shard run in parallel and each shard resizes
+ * on its own without stopping the other ones. Keys are hashed once per operation: the shard reuses
+ * the hash that picked it (@see strukts_hashmap_hash_key).
+ */
+
+#ifndef STRUKTS_CONCURRENT_HASHMAP_H
+#define STRUKTS_CONCURRENT_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "strukts_hashmap.h"
+
+#define STRUKTS_CONCURRENT_HASHMAP_CACHE_LINE 64 /* shards are aligned to avoid false sharing */
+
+/**
+ * A shard of the concurrent hash map: a hash map guarded by a reader-writer lock.
+ */
+typedef struct _StruktsConcurrentHashmapShard StruktsConcurrentHashmapShard;
+
+struct _StruktsConcurrentHashmapShard {
+    pthread_rwlock_t lock;
+    StruktsHashmap* hashmap;
+} __attribute__((aligned(STRUKTS_CONCURRENT_HASHMAP_CACHE_LINE)));
+
+/**
+ * Represents a thread-safe hash map made of independently locked shards.
+ */
+typedef struct _StruktsConcurrentHashmap StruktsConcurrentHashmap;
+
+struct _StruktsConcurrentHashmap {
+    size_t shards_amount;                  /* amount of shards: always a power of 2 */
+    unsigned int shard_bits;               /* log2(shards_amount) */
+    StruktsConcurrentHashmapShard* shards; /* cache line aligned array of shards */
+    void* shards_memory;                   /* allocated memory that holds the aligned shards */
+};
+
+/**
+ * Allocates a new concurrent hash map with the given amount of shards (rounded up to a power of 2).
+ * Each shard is a hash map created with strukts_hashmap_new_with_flags(flags), except for the
+ * STRUKTS_HASHMAP_INCREMENTAL_REHASH flag which is ignored because its lookups mutate the shard.
+ *
+ * @param shards_amount is the amount of independently locked shards (such as the amount of cores).
+ * @param flags is a bitwise or of STRUKTS_HASHMAP_* flags (or STRUKTS_HASHMAP_DEFAULT).
+ *
+ * @return a pointer to an empty concurrent hash map; NULL if any allocation failed.
+ */
+StruktsConcurrentHashmap* strukts_concurrent_hashmap_new(size_t shards_amount, unsigned int flags);
+
+/**
+ * Deallocates all memory previously allocated by the concurrent hash map and its shards. No other
+ * thread may be using the hash map.
+ *
+ * @param hashmap is the concurrent hash map to deallocate.
+ */
+void strukts_concurrent_hashmap_free(StruktsConcurrentHashmap* hashmap);
+
+/**
+ * Adds or replaces a key (and its value) in the concurrent hash map, holding the write lock of the
+ * key's shard only. @see strukts_hashmap_upsert.
+ *
+ * @param hashmap is a pointer to a concurrent hash map.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_concurrent_hashmap_upsert(StruktsConcurrentHashmap* hashmap, const char* key,
+                                       char* value);
+
+/**
+ * Removes a key (and its value) from the concurrent hash map, holding the write lock of the key's
+ * shard only. @see strukts_hashmap_remove.
+ *
+ * @param hashmap is a pointer to a concurrent hash map.
+ * @param key is a pointer to a string key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_concurrent_hashmap_remove(StruktsConcurrentHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a given key in the concurrent hash map holding the read lock of the key's shard, so
+ * lookups of many threads on the same shard run in parallel.
+ *
+ * @param hashmap is a pointer to a concurrent hash map.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_concurrent_hashmap_get(StruktsConcurrentHashmap* hashmap, const char* key);
+
+/**
+ * Gets the total amount of keys of all shards (each shard is read locked while it's counted).
+ *
+ * @param hashmap is a pointer to a concurrent hash map.
+ *
+ * @return the amount of keys in the concurrent hash map.
+ */
+size_t strukts_concurrent_hashmap_size(StruktsConcurrentHashmap* hashmap);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_CONCURRENT_HASHMAP_H */
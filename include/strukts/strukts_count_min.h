@@ -0,0 +1,122 @@
+/**
+ * @file strukts_count_min.h
+ *
+ * @brief Module that contains a Count-Min sketch implementation: a fixed size table of counters
+ * that estimates how many times each key was added (its frequency), such as to find heavy hitters
+ * in a stream of keys. To create a new empty Count-Min sketch, @see strukts_count_min_new.
+ *
+ * The sketch has depth rows of width counters. Each key is hashed once by the 128-bit murmur3
+ * variant and its counter in row i is derived from two hashes by double hashing (h1 + i * h2, h1
+ * and h2 being the lower 32 bits of each half of the hash). A key's frequency is estimated as the
+ * smallest of its depth counters: estimates are never lower than the real frequency and, with
+ * probability 1 - delta, exceed it by at most epsilon * total count.
+ *
+ * Counters are updated conservatively: adding a key only raises its counters that are lower than
+ * its new estimate, which keeps the error of the other keys sharing those counters lower than
+ * incrementing all of them. Counters saturate at UINT32_MAX.
+ */
+
+#ifndef STRUKTS_COUNT_MIN_H
+#define STRUKTS_COUNT_MIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_COUNT_MIN_MAX_DEPTH 16 /* rows at most (delta >= e^-16) */
+#define STRUKTS_COUNT_MIN_SEED 0       /* seed of the key hashes */
+
+/**
+ * Represents a Count-Min sketch.
+ */
+typedef struct _StruktsCountMin StruktsCountMin;
+
+struct _StruktsCountMin {
+    size_t width;       /* counters per row: always a power of 2 */
+    size_t depth;       /* amount of rows */
+    uint64_t total;     /* sum of all added counts */
+    uint32_t* counters; /* depth rows of width counters */
+};
+
+/**
+ * Allocates a new empty Count-Min sketch whose estimates exceed the real frequencies by at most
+ * epsilon * total count with probability 1 - delta: width = e / epsilon (rounded up to a power of
+ * 2) and depth = ln(1 / delta) rows.
+ *
+ * @param epsilon is the error relative to the total count, in (0, 1).
+ * @param delta is the probability of exceeding the error, in (0, 1).
+ *
+ * @return a pointer to an empty Count-Min sketch; NULL if epsilon or delta are not in (0, 1) or if
+ * any allocation failed.
+ */
+StruktsCountMin* strukts_count_min_new(double epsilon, double delta);
+
+/**
+ * Deallocates all memory previously allocated by the Count-Min sketch.
+ *
+ * @param sketch is the Count-Min sketch to deallocate.
+ */
+void strukts_count_min_free(StruktsCountMin* sketch);
+
+/**
+ * Adds count occurrences of a key to the Count-Min sketch.
+ *
+ * @param sketch is a pointer to a Count-Min sketch.
+ * @param key is a pointer to a string key.
+ * @param count is the amount of occurrences of the key.
+ */
+void strukts_count_min_add(StruktsCountMin* sketch, const char* key, uint32_t count);
+
+/**
+ * Adds count occurrences of a key of key_len bytes to the Count-Min sketch. Works just like
+ * strukts_count_min_add.
+ *
+ * @param sketch is a pointer to a Count-Min sketch.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ * @param count is the amount of occurrences of the key.
+ */
+void strukts_count_min_add_n(StruktsCountMin* sketch, const void* key, size_t key_len,
+                             uint32_t count);
+
+/**
+ * Adds one occurrence of each of n keys to the Count-Min sketch. Works just like calling
+ * strukts_count_min_add with a count of 1 for each key.
+ *
+ * @param sketch is a pointer to a Count-Min sketch.
+ * @param keys is an array of n string keys (repeated keys are counted once per occurrence).
+ * @param n is the amount of keys.
+ */
+void strukts_count_min_add_many(StruktsCountMin* sketch, const char* const keys[], size_t n);
+
+/**
+ * Estimates how many times a key was added to the Count-Min sketch.
+ *
+ * @param sketch is a pointer to a Count-Min sketch.
+ * @param key is a pointer to a string key.
+ *
+ * @return the estimated frequency of the key: never lower than its real frequency.
+ */
+uint32_t strukts_count_min_estimate(const StruktsCountMin* sketch, const char* key);
+
+/**
+ * Estimates how many times a key of key_len bytes was added to the Count-Min sketch. Works just
+ * like strukts_count_min_estimate.
+ *
+ * @param sketch is a pointer to a Count-Min sketch.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return the estimated frequency of the key: never lower than its real frequency.
+ */
+uint32_t strukts_count_min_estimate_n(const StruktsCountMin* sketch, const void* key,
+                                      size_t key_len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_COUNT_MIN_H */
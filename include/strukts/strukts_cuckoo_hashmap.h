@@ -0,0 +1,110 @@
+/**
+ * @file strukts_cuckoo_hashmap.h
+ *
+ * @brief Module that contains a bucketized cuckoo hash map implementation. To create a new empty
+ * cuckoo hash map, @see strukts_cuckoo_hashmap_new.
+ *
+ * Each key has exactly two candidate buckets, chosen by two independently seeded murmur3 hashes,
+ * and each bucket holds up to 4 keys in a single cache line. Lookups therefore read, at most, two
+ * buckets: their worst case is bounded no matter how the keys collide (unlike a chaining bucket).
+ *
+ * When both buckets of a new key are full, a breadth-first search looks for the shortest path of
+ * displacements ("cuckoo path") that moves keys to their alternate buckets until a free slot is
+ * reached. If no short path exists, the hash map doubles its amount of buckets.
+ */
+
+#ifndef STRUKTS_CUCKOO_HASHMAP_H
+#define STRUKTS_CUCKOO_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_CUCKOO_HASHMAP_CACHE_LINE 64
+#define STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS 4 /* keys per bucket (4-way) */
+#define STRUKTS_CUCKOO_HASHMAP_INITIAL_BUCKETS 4
+#define STRUKTS_CUCKOO_HASHMAP_MAX_LOAD_FACTOR 0.95
+#define STRUKTS_CUCKOO_HASHMAP_SEED 0               /* seed of the first hash of the keys */
+#define STRUKTS_CUCKOO_HASHMAP_ALT_SEED 0x5bd1e995u /* seed of the second hash of the keys */
+
+/**
+ * A cache line sized bucket: both hashes of each key are kept, so keys are only compared when both
+ * hashes match and displacements find the alternate bucket of a key without reading/hashing it.
+ */
+typedef struct _StruktsCuckooHashmapBucket StruktsCuckooHashmapBucket;
+
+struct _StruktsCuckooHashmapBucket {
+    uint32_t hashes[STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS];     /* first hashes of the keys */
+    uint32_t alt_hashes[STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS]; /* second hashes of the keys */
+    const char* keys[STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS];    /* NULL for empty slots */
+} __attribute__((aligned(STRUKTS_CUCKOO_HASHMAP_CACHE_LINE)));
+
+/**
+ * Represents a 4-way bucketized cuckoo hash map.
+ */
+typedef struct _StruktsCuckooHashmap StruktsCuckooHashmap;
+
+struct _StruktsCuckooHashmap {
+    size_t size;                         /* amount of keys so far */
+    size_t buckets_amount;               /* always a power of 2 */
+    StruktsCuckooHashmapBucket* buckets; /* cache line aligned array of buckets */
+    void* buckets_memory;                /* allocated memory that holds the aligned buckets */
+    char** values;                       /* values of the slots: bucket * 4 + slot */
+};
+
+/**
+ * Allocates a new empty cuckoo hash map with STRUKTS_CUCKOO_HASHMAP_INITIAL_BUCKETS buckets.
+ *
+ * @return a pointer to an empty cuckoo hash map; NULL if any allocation failed.
+ */
+StruktsCuckooHashmap* strukts_cuckoo_hashmap_new();
+
+/**
+ * Deallocates all memory previously allocated by the cuckoo hash map.
+ *
+ * @param hashmap is the cuckoo hash map to deallocate.
+ */
+void strukts_cuckoo_hashmap_free(StruktsCuckooHashmap* hashmap);
+
+/**
+ * Adds a new key (and its value) to the hash map or replaces the value of an existing key. Keys
+ * may be displaced to their alternate buckets and the hash map may double its amount of buckets
+ * (when its load factor would exceed STRUKTS_CUCKOO_HASHMAP_MAX_LOAD_FACTOR or no cuckoo path is
+ * found). The hashmap pointer itself never changes.
+ *
+ * @param hashmap is a pointer to a cuckoo hash map.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_cuckoo_hashmap_upsert(StruktsCuckooHashmap* hashmap, const char* key, char* value);
+
+/**
+ * Removes a key (and its value) from the cuckoo hash map.
+ *
+ * @param hashmap is a pointer to a cuckoo hash map.
+ * @param key is a pointer to a string key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_cuckoo_hashmap_remove(StruktsCuckooHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a given key in its two candidate buckets only.
+ *
+ * @param hashmap is a pointer to a cuckoo hash map.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_cuckoo_hashmap_get(const StruktsCuckooHashmap* hashmap, const char* key);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_CUCKOO_HASHMAP_H */
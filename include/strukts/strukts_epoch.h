@@ -0,0 +1,144 @@
+/**
+ * @file strukts_epoch.h
+ *
+ * @brief Module that contains an epoch-based reclamation (EBR) scheme used by lock-free data
+ * structures to safely deallocate memory that concurrent readers may still be reading. To create
+ * a new epoch domain, @see strukts_epoch_domain_new.
+ *
+ * Readers announce the global epoch they've observed when they enter a read-side critical section
+ * (a plain store followed by a memory fence: no locks and no atomic read-modify-write operations)
+ * and clear it when they leave. Writers unlink objects from the data structure and retire them
+ * into the limbo list of the current epoch. The global epoch only advances once every active
+ * reader has observed it, so objects retired two epochs ago can't be reached by any reader anymore
+ * and are finally deallocated.
+ *
+ * Writers (retire and reclamation) must be serialized by the caller, such as with a mutex.
+ */
+
+#ifndef STRUKTS_EPOCH_H
+#define STRUKTS_EPOCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_EPOCH_CACHE_LINE 64 /* readers are aligned to avoid false sharing */
+#define STRUKTS_EPOCH_LIMBO_LISTS 3 /* retired objects of the current and two previous epochs */
+
+/**
+ * A reader slot: its state is 0 outside read-side critical sections. Inside them, the state is the
+ * observed global epoch shifted left by one bit with the lowest bit set.
+ */
+typedef struct _StruktsEpochReader StruktsEpochReader;
+
+struct _StruktsEpochReader {
+    uint64_t state;  /* accessed with atomic loads/stores only */
+    bool registered; /* whether the slot is owned by a reader thread */
+} __attribute__((aligned(STRUKTS_EPOCH_CACHE_LINE)));
+
+/**
+ * An object that has been unlinked from a data structure and waits to be deallocated.
+ */
+typedef struct _StruktsEpochRetired StruktsEpochRetired;
+
+struct _StruktsEpochRetired {
+    StruktsEpochRetired* next;
+    void* object;
+    void (*free_object)(void* object); /* deallocation function of the object */
+};
+
+/**
+ * Represents an epoch domain: a global epoch, the reader slots and the limbo lists.
+ */
+typedef struct _StruktsEpochDomain StruktsEpochDomain;
+
+struct _StruktsEpochDomain {
+    uint64_t global_epoch;       /* accessed with atomic loads/stores only */
+    size_t readers_capacity;     /* maximum amount of registered readers */
+    StruktsEpochReader* readers; /* cache line aligned array of reader slots */
+    void* readers_memory;        /* allocated memory that holds the aligned reader slots */
+    StruktsEpochRetired* limbo[STRUKTS_EPOCH_LIMBO_LISTS]; /* retired objects by epoch % 3 */
+    size_t retired_amount; /* amount of objects waiting to be deallocated */
+};
+
+/**
+ * Allocates a new epoch domain with room for readers_capacity concurrent readers.
+ *
+ * @param readers_capacity is the maximum amount of registered readers.
+ *
+ * @return a pointer to a new epoch domain; NULL if any allocation failed.
+ */
+StruktsEpochDomain* strukts_epoch_domain_new(size_t readers_capacity);
+
+/**
+ * Deallocates the epoch domain and every retired object still waiting in its limbo lists. No reader
+ * may be inside a read-side critical section.
+ *
+ * @param domain is the epoch domain to deallocate.
+ */
+void strukts_epoch_domain_free(StruktsEpochDomain* domain);
+
+/**
+ * Registers a new reader in the epoch domain. Must be serialized with the writers.
+ *
+ * @param domain is an epoch domain.
+ *
+ * @return a reader slot to be used by a single thread; NULL if all slots are taken.
+ */
+StruktsEpochReader* strukts_epoch_reader_register(StruktsEpochDomain* domain);
+
+/**
+ * Releases a reader slot so that it can be registered again. Must be serialized with the writers.
+ *
+ * @param domain is an epoch domain.
+ * @param reader is a reader slot outside of a read-side critical section.
+ */
+void strukts_epoch_reader_unregister(StruktsEpochDomain* domain, StruktsEpochReader* reader);
+
+/**
+ * Enters a read-side critical section: objects read afterwards won't be deallocated until the
+ * reader calls strukts_epoch_exit.
+ *
+ * @param domain is an epoch domain.
+ * @param reader is the reader slot of the calling thread.
+ */
+void strukts_epoch_enter(StruktsEpochDomain* domain, StruktsEpochReader* reader);
+
+/**
+ * Leaves a read-side critical section.
+ *
+ * @param reader is the reader slot of the calling thread.
+ */
+void strukts_epoch_exit(StruktsEpochReader* reader);
+
+/**
+ * Retires an object that has already been unlinked from the data structure: it's deallocated
+ * with free_object once no reader can reach it anymore. Must be called by a (serialized) writer.
+ *
+ * @param domain is an epoch domain.
+ * @param object is the unlinked object.
+ * @param free_object is the function used to deallocate the object.
+ *
+ * @return true if the object was retired; false if retiring failed (the object is not retired).
+ */
+bool strukts_epoch_retire(StruktsEpochDomain* domain, void* object, void (*free_object)(void*));
+
+/**
+ * Tries to advance the global epoch, which is only possible when every active reader has observed
+ * the current epoch. When it advances, objects retired two epochs ago are deallocated. Must be
+ * called by a (serialized) writer.
+ *
+ * @param domain is an epoch domain.
+ *
+ * @return true if the global epoch advanced; false otherwise.
+ */
+bool strukts_epoch_try_reclaim(StruktsEpochDomain* domain);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_EPOCH_H */
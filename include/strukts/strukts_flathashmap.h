@@ -0,0 +1,93 @@
+/**
+ * @file strukts_flathashmap.h
+ *
+ * @brief Module that contains an "open addressing" hash map implementation. To create a new
+ * empty flat hash map, @see strukts_flathashmap_new.
+ *
+ * Unlike the "separate chaining" hash map of strukts_hashmap.h, the flat hash map keeps all of
+ * its keys/values in a single flat array of slots plus a metadata array of 1-byte control tags
+ * (one per slot) taken from each key's murmur3 hash. Lookups match groups of 16 control tags at
+ * once (with SSE2 instructions when available, or a scalar fallback otherwise) and only compare
+ * the keys of the slots whose tags match, so no linked list nodes are chased around.
+ */
+
+#ifndef STRUKTS_FLATHASHMAP_H
+#define STRUKTS_FLATHASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_FLATHASHMAP_GROUP_WIDTH 16 /* amount of control tags matched at once */
+#define STRUKTS_FLATHASHMAP_INITIAL_CAPACITY 16
+#define STRUKTS_FLATHASHMAP_MAX_LOAD_FACTOR 0.875
+
+/**
+ * A slot of the flat hash map which holds a key and its value (satellite data).
+ */
+typedef struct _StruktsFlatHashmapSlot StruktsFlatHashmapSlot;
+
+struct _StruktsFlatHashmapSlot {
+    const char* key; /* 'id' for the values, should not be mutated */
+    char* value;
+};
+
+/**
+ * Represents a hash map that uses "open addressing" to deal with hashing collisions.
+ */
+typedef struct _StruktsFlatHashmap StruktsFlatHashmap;
+
+struct _StruktsFlatHashmap {
+    size_t size;                   /* amount of keys so far */
+    size_t capacity;               /* amount of slots: a power of 2 multiple of the group width */
+    uint8_t* controls;             /* control tags: one byte per slot (empty or the key's tag) */
+    StruktsFlatHashmapSlot* slots; /* flat array of key/value slots */
+};
+
+/**
+ * Allocates a new flat hash map whose initial capacity (amount of slots) is
+ * STRUKTS_FLATHASHMAP_INITIAL_CAPACITY (16) which can be used to store keys and values.
+ *
+ * @return a pointer to an empty flat hashmap.
+ */
+StruktsFlatHashmap* strukts_flathashmap_new();
+
+/**
+ * Deallocates all memory previously allocated by the flat hashmap and its inner structures.
+ *
+ * @param hashmap is the flat hash map to deallocate.
+ */
+void strukts_flathashmap_free(StruktsFlatHashmap* hashmap);
+
+/**
+ * Adds a new key (and its value) to a flat hash map. If the key is already in the hash map, its
+ * value is replaced. If the load factor would become bigger than
+ * STRUKTS_FLATHASHMAP_MAX_LOAD_FACTOR (0.875), the slots are reallocated with twice as much
+ * capacity and all current keys/values are reinserted. The hashmap pointer itself never changes.
+ *
+ * @param hashmap is a pointer to a flat hashmap.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added to the hashmap. False, otherwise.
+ */
+bool strukts_flathashmap_add(StruktsFlatHashmap* hashmap, const char* key, char* value);
+
+/**
+ * Searches for a given key in the flat hash map and returns its value if the key was found.
+ *
+ * @param hashmap is a pointer to a flat hashmap.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_flathashmap_get(const StruktsFlatHashmap* hashmap, const char* key);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_FLATHASHMAP_H */
@@ -0,0 +1,96 @@
+/**
+ * @file strukts_frozen_hashmap.h
+ *
+ * @brief Module that contains a read-only hash map of a static set of keys, built once and never
+ * modified. To create a new frozen hash map, @see strukts_frozen_hashmap_new.
+ *
+ * The keys are mapped to [0, n) by a minimal perfect hash function (@see
+ * strukts_perfect_hash.h), so the entries live in a dense array of exactly n entries: no buckets,
+ * no chains, no next pointers and no empty slots. A lookup computes the perfect hash of the key (a
+ * single murmur3 hash for most keys) and reads one entry, whose key is compared to reject keys that
+ * are not in the set.
+ */
+
+#ifndef STRUKTS_FROZEN_HASHMAP_H
+#define STRUKTS_FROZEN_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "strukts_perfect_hash.h"
+
+/**
+ * An entry of the frozen hash map's dense array.
+ */
+typedef struct _StruktsFrozenHashmapEntry StruktsFrozenHashmapEntry;
+
+struct _StruktsFrozenHashmapEntry {
+    const char* key; /* should not be mutated */
+    size_t key_len;  /* amount of bytes of the key */
+    char* value;
+};
+
+/**
+ * Represents a read-only hash map of a static set of keys.
+ */
+typedef struct _StruktsFrozenHashmap StruktsFrozenHashmap;
+
+struct _StruktsFrozenHashmap {
+    size_t size;                        /* amount of keys */
+    StruktsPerfectHash* perfect_hash;   /* maps each key to the index of its entry */
+    StruktsFrozenHashmapEntry* entries; /* dense array of size entries */
+};
+
+/**
+ * Allocates a new frozen hash map with n keys and their values. The keys' bytes are not copied:
+ * they must outlive the frozen hash map.
+ *
+ * @param keys is an array of n distinct string keys.
+ * @param values is an array of n string values: values[i] is the value of keys[i].
+ * @param n is the amount of keys/values.
+ *
+ * @return a pointer to a frozen hash map; NULL if any allocation failed or if the perfect hash
+ * function could not be built (such as with duplicate keys).
+ */
+StruktsFrozenHashmap* strukts_frozen_hashmap_new(const char* const keys[], char* const values[],
+                                                 size_t n);
+
+/**
+ * Deallocates all memory previously allocated by the frozen hash map.
+ *
+ * @param hashmap is the frozen hash map to deallocate.
+ */
+void strukts_frozen_hashmap_free(StruktsFrozenHashmap* hashmap);
+
+/**
+ * Searches for a given key in the frozen hash map and returns its value if the key was found.
+ *
+ * @param hashmap is a pointer to a frozen hash map.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_frozen_hashmap_get(const StruktsFrozenHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a key of key_len bytes in the frozen hash map. Works just like
+ * strukts_frozen_hashmap_get.
+ *
+ * @param hashmap is a pointer to a frozen hash map.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_frozen_hashmap_get_n(const StruktsFrozenHashmap* hashmap, const void* key,
+                                   size_t key_len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_FROZEN_HASHMAP_H */
@@ -8,6 +8,21 @@
  * for preimage resistance, i.e., they are not hard to reverse by an adversary.
  *
  * The original MurMur hash algorithm was designed by Austin Appleby in 2008.
+ *
+ * Two MurMur3 variants are available: the x86 32-bit variant (strukts_murmur3_hash), which consumes
+ * 4 bytes per round, and the x64 128-bit variant (strukts_murmur3_hash_x64_128), which consumes
+ * 16 bytes per round with 64-bit multiplications. The latter is several times faster on long keys
+ * and its 128 bits are wide enough to be used as fingerprints of keys among billions of others.
+ *
+ * Keys split into fragments (such as the iovec fragments of network buffers) can be hashed by the
+ * 32-bit variant without copying them into a contiguous buffer: a streaming context (@see
+ * strukts_murmur3_init) is updated with each fragment and carries the partial 4-byte block of a
+ * fragment over to the next one. The resulting hash is the same one of strukts_murmur3_hash.
+ *
+ * Many keys of the same length can be hashed at once by the 32-bit variant with SIMD instructions
+ * (@see strukts_murmur3_hash_many): each vector lane runs the rounds of one key, so AVX2 hashes 8
+ * keys per pass and AVX-512 hashes 16. The instruction set is picked at runtime (CPUID), with a
+ * scalar fallback, and the hashes are the same ones of strukts_murmur3_hash.
  */
 
 #ifndef STRUKTS_HASHING_H
@@ -20,6 +35,24 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <sys/uio.h>
+
+/* instruction sets of strukts_murmur3_hash_many, from the slowest to the fastest one */
+#define STRUKTS_MURMUR3_SCALAR 0
+#define STRUKTS_MURMUR3_AVX2 1   /* 8 keys per pass */
+#define STRUKTS_MURMUR3_AVX512 2 /* 16 keys per pass */
+
+/**
+ * Streaming state of the 32-bit MurMur3 hashing of a key whose bytes are given in fragments.
+ */
+typedef struct _StruktsMurmur3Context StruktsMurmur3Context;
+
+struct _StruktsMurmur3Context {
+    uint32_t hash;   /* hash of the whole 4-byte blocks consumed so far */
+    uint8_t tail[4]; /* bytes of the partial block, waiting for the next fragment */
+    size_t tail_len; /* amount of bytes in tail (0 to 3) */
+    size_t key_len;  /* amount of bytes of all fragments consumed so far */
+};
 
 /**
  * Hashes a key using the MurMur3 hashing algorithm to produce a 32-bit sized hash.
@@ -32,6 +65,98 @@ extern "C" {
  */
 uint32_t strukts_murmur3_hash(const uint8_t* key, size_t key_len, uint32_t seed);
 
+/**
+ * Hashes a key using the MurMur3 x64 128-bit hashing algorithm to produce a 128-bit sized hash
+ * (the same hash of MurmurHash3_x64_128 on little endian machines).
+ *
+ * @param key is a pointer to an array of bytes (of 8 bits) to be hashed.
+ * @param key_len is the amount of bytes that key points to (size of the bytes array).
+ * @param seed is a random seed used by the algorithm.
+ * @param out is where the hash is written: its lower 64 bits in out[0], its upper ones in out[1].
+ */
+void strukts_murmur3_hash_x64_128(const uint8_t* key, size_t key_len, uint32_t seed,
+                                  uint64_t out[2]);
+
+/**
+ * Starts the streaming hashing of a key with the 32-bit MurMur3 hashing algorithm.
+ *
+ * @param context is a pointer to the streaming context to initialize.
+ * @param seed is a random seed used by the algorithm.
+ */
+void strukts_murmur3_init(StruktsMurmur3Context* context, uint32_t seed);
+
+/**
+ * Hashes the next fragment of a key. Fragments can have any length (including 0) and are hashed
+ * in place: no bytes are copied other than the partial 4-byte block at the fragment's end.
+ *
+ * @param context is a pointer to a streaming context started by strukts_murmur3_init.
+ * @param fragment is a pointer to the fragment's bytes.
+ * @param fragment_len is the amount of bytes of the fragment.
+ */
+void strukts_murmur3_update(StruktsMurmur3Context* context, const uint8_t* fragment,
+                            size_t fragment_len);
+
+/**
+ * Ends the streaming hashing of a key.
+ *
+ * @param context is a pointer to a streaming context updated with all fragments of the key.
+ *
+ * @return the hash of the key: the same one returned by strukts_murmur3_hash for the
+ * concatenation of all fragments (with the same seed).
+ */
+uint32_t strukts_murmur3_final(const StruktsMurmur3Context* context);
+
+/**
+ * Hashes a key given as iovec fragments (such as the ones of readv/recvmsg) with the 32-bit
+ * MurMur3 hashing algorithm, without copying the fragments.
+ *
+ * @param fragments is an array of fragments_amount iovec fragments of the key, in order.
+ * @param fragments_amount is the amount of fragments.
+ * @param seed is a random seed used by the algorithm.
+ *
+ * @return the same hash returned by strukts_murmur3_hash for the concatenation of the fragments.
+ */
+uint32_t strukts_murmur3_hash_iov(const struct iovec* fragments, size_t fragments_amount,
+                                  uint32_t seed);
+
+/**
+ * Gets the fastest instruction set that strukts_murmur3_hash_many can use on this CPU (detected
+ * once with CPUID).
+ *
+ * @return STRUKTS_MURMUR3_AVX512, STRUKTS_MURMUR3_AVX2 or STRUKTS_MURMUR3_SCALAR.
+ */
+unsigned int strukts_murmur3_simd_level();
+
+/**
+ * Hashes n keys of key_len bytes each with the 32-bit MurMur3 hashing algorithm, using the fastest
+ * instruction set of the CPU (@see strukts_murmur3_simd_level).
+ *
+ * @param keys is an array of n pointers to the keys' bytes.
+ * @param key_len is the amount of bytes of every key.
+ * @param n is the amount of keys.
+ * @param seed is a random seed used by the algorithm.
+ * @param hashes is an array of n hashes where hashes[i] is set to the hash of keys[i]: the same one
+ * returned by strukts_murmur3_hash.
+ */
+void strukts_murmur3_hash_many(const uint8_t* const keys[], size_t key_len, size_t n,
+                               uint32_t seed, uint32_t hashes[]);
+
+/**
+ * Hashes n keys of key_len bytes each, just like strukts_murmur3_hash_many, using an instruction
+ * set no faster than the given one (such as STRUKTS_MURMUR3_SCALAR to benchmark the fallback).
+ *
+ * @param keys is an array of n pointers to the keys' bytes.
+ * @param key_len is the amount of bytes of every key.
+ * @param n is the amount of keys.
+ * @param seed is a random seed used by the algorithm.
+ * @param hashes is an array of n hashes where hashes[i] is set to the hash of keys[i].
+ * @param simd_level is the fastest instruction set to use (a STRUKTS_MURMUR3_* level). Levels not
+ * supported by the CPU fall back to the fastest supported one.
+ */
+void strukts_murmur3_hash_many_with_level(const uint8_t* const keys[], size_t key_len, size_t n,
+                                          uint32_t seed, uint32_t hashes[],
+                                          unsigned int simd_level);
+
 #ifdef __cplusplus
 }
 #endif
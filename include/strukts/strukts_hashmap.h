@@ -5,7 +5,53 @@
  * To create a new empty hashmap, @see strukts_hashmap_new.
  *
  * The hash map created by strukts_hashmap_new implements a hash map using "separate
- * chaining" as the default way to handle hashing collisions.
+ * chaining" as the default way to handle hashing collisions. Each entry of a bucket's chain keeps
+ * the murmur3 hash and the length of its key: rehashing never hashes key bytes again and key bytes
+ * are only compared when both the hash and the length match.
+ *
+ * A hash map pointer never changes during its lifetime: growing or shrinking only swaps its inner
+ * bucket arrays, so the pointer returned by strukts_hashmap_new can be shared by other structures
+ * (and by threads that synchronize their accesses) without being fetched again after each addition.
+ *
+ * Keys are C strings by default. The "_n" variants of the functions (such as strukts_hashmap_add_n)
+ * take a pointer to the key's bytes and its length instead, so binary keys and slices of bigger
+ * buffers can be used without NUL-terminated copies (and without calling strlen on every call).
+ *
+ * By default, growing the hash map rehashes all of its keys at once. Hash maps created with the
+ * STRUKTS_HASHMAP_INCREMENTAL_REHASH flag (@see strukts_hashmap_new_with_flags) keep the old and
+ * the new bucket arrays side by side instead and every add/get migrates, at most,
+ * STRUKTS_HASHMAP_REHASH_STEP buckets until the old bucket array is drained.
+ *
+ * Hash maps created with the STRUKTS_HASHMAP_ARENA flag allocate their entries from large slabs of
+ * an arena (@see strukts_arena.h) instead of one malloc per entry, and release all of them at once
+ * when the hash map is deallocated.
+ *
+ * Hash maps created with the STRUKTS_HASHMAP_SHRINK flag halve their capacity when removals make
+ * the load factor drop below STRUKTS_HASHMAP_MIN_LOAD_FACTOR.
+ *
+ * Hash maps created with the STRUKTS_HASHMAP_OWN_KEYS flag copy their keys, so callers don't have
+ * to keep them alive. Keys shorter than STRUKTS_HASHMAP_INLINE_KEY_SIZE bytes are stored inline
+ * right after their entry (64 bytes in total on 64-bit platforms). Their entries are always
+ * allocated from an arena, whose items start at cache line boundaries, so each entry and its inline
+ * key fill exactly one cache line and comparing them reads no other one. Longer keys get an
+ * allocation of their own, which is deallocated as soon as their entry is removed.
+ *
+ * Keys are hashed by the 32-bit murmur3 variant by default. Hash maps created with the
+ * STRUKTS_HASHMAP_MURMUR3_128 flag hash them with the 128-bit variant instead (@see
+ * strukts_murmur3_hash_x64_128), which is several times faster on long keys (such as URLs or file
+ * paths), and keep its lower 32 bits.
+ *
+ * Entries can be enumerated in two ways: an iterator (@see strukts_hashmap_iterator_init) walks the
+ * bucket arrays front to back in a single pass while the hash map is not modified, and a cursor
+ * (@see strukts_hashmap_scan) visits a few buckets per call, like the SCAN command of Redis, and
+ * remains valid even if the hash map grows or shrinks between calls.
+ *
+ * The health of a hash map (load factor, chain lengths, rehashing work and memory) can be inspected
+ * with strukts_hashmap_stats. When compiled with STRUKTS_HASHMAP_OP_COUNTERS defined (cmake option
+ * WITH_HASHMAP_OP_COUNTERS), lookups also count their hits, misses and key comparisons.
+ *
+ * A Bloom filter can be attached in front of a hash map (@see strukts_hashmap_attach_bloom_filter):
+ * lookups of missing keys are then mostly rejected by the filter without walking any chain.
  */
 
 #ifndef STRUKTS_HASHMAP_H
@@ -15,7 +61,12 @@
 extern "C" {
 #endif
 
-#include "strukts_linkedlist.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "strukts_arena.h"
+#include "strukts_bloom_filter.h"
 
 #ifdef DEBUG
 #define STRUKTS_HASHMAP_INITIAL_CAPACITY 1
@@ -24,6 +75,47 @@ extern "C" {
 #endif
 
 #define STRUKTS_HASHMAP_MAX_LOAD_FACTOR 0.7
+#define STRUKTS_HASHMAP_MIN_LOAD_FACTOR 0.1 /* shrinking threshold with STRUKTS_HASHMAP_SHRINK */
+#define STRUKTS_HASHMAP_REHASH_STEP 4 /* buckets migrated per operation on incremental rehashing */
+#define STRUKTS_HASHMAP_ARENA_SLAB_ITEMS 4096 /* entries per slab for arena allocated hash maps */
+#define STRUKTS_HASHMAP_GET_MANY_BATCH 32     /* keys whose lookups are interleaved at once */
+#define STRUKTS_HASHMAP_BUILD_MAX_THREADS 64  /* threads used by strukts_hashmap_build at most */
+#define STRUKTS_HASHMAP_INLINE_KEY_SIZE 24    /* inline key bytes (with NUL) for owned keys */
+#define STRUKTS_HASHMAP_STATS_CHAINS 8        /* chain length histogram: 0, 1, ..., 7 or longer */
+
+/* hash map flags: can be combined with bitwise or */
+#define STRUKTS_HASHMAP_DEFAULT 0
+#define STRUKTS_HASHMAP_INCREMENTAL_REHASH (1u << 0)
+#define STRUKTS_HASHMAP_ARENA (1u << 1)
+#define STRUKTS_HASHMAP_SHRINK (1u << 2)
+#define STRUKTS_HASHMAP_OWN_KEYS (1u << 3)
+#define STRUKTS_HASHMAP_MURMUR3_128 (1u << 4)
+
+/**
+ * An entry of a bucket's chain (singly linked list) which holds a key and its value.
+ */
+typedef struct _StruktsHashmapEntry StruktsHashmapEntry;
+
+struct _StruktsHashmapEntry {
+    StruktsHashmapEntry* next; /* next entry of the same bucket */
+    const char* key;           /* 'id' for the values (key_len bytes), should not be mutated */
+    char* value;
+    size_t key_len; /* amount of bytes of the key */
+    uint32_t hash;  /* murmur3 hash of the key (lower 32 bits with STRUKTS_HASHMAP_MURMUR3_128) */
+};
+
+/**
+ * Per-operation counters of lookups (strukts_hashmap_get* functions). They are only updated when
+ * the library is compiled with STRUKTS_HASHMAP_OP_COUNTERS defined; otherwise, they stay 0.
+ */
+typedef struct _StruktsHashmapOpCounters StruktsHashmapOpCounters;
+
+struct _StruktsHashmapOpCounters {
+    uint64_t gets;        /* amount of searched keys */
+    uint64_t hits;        /* amount of searched keys that were found */
+    uint64_t misses;      /* amount of searched keys that were not found */
+    uint64_t comparisons; /* amount of chain entries compared against the searched keys */
+};
 
 /**
  * Represents a hash map (a.k.a as hash tables or symbol tables) using "separate chaining"
@@ -34,7 +126,54 @@ typedef struct _StruktsHashmap StruktsHashmap;
 struct _StruktsHashmap {
     size_t size;                 /* amount of keys so far */
     size_t capacity;             /* amount of available buckets (capacity) */
-    StruktsLinkedList** buckets; /* pointer to an array of buckets (linked lists for collisions) */
+    StruktsHashmapEntry** buckets; /* pointer to an array of buckets (chains for collisions) */
+    unsigned int flags;            /* STRUKTS_HASHMAP_* flags used to create the hash map */
+    StruktsArena* arena;           /* entries allocator: NULL without ARENA/OWN_KEYS flags */
+    size_t key_bytes;              /* bytes allocated by long owned keys (one malloc each) */
+    StruktsBloomFilter* bloom_filter; /* filter of missing keys: NULL unless one is attached */
+
+    /* rehashing state: old_buckets is NULL whenever no rehashing is in progress */
+    size_t old_capacity;               /* amount of buckets of the old bucket array */
+    StruktsHashmapEntry** old_buckets; /* old bucket array which is being drained */
+    size_t rehash_index;               /* next old bucket to be migrated to the new bucket array */
+
+    /* instrumentation */
+    size_t rehashes;                      /* amount of rehashings started (growing or shrinking) */
+    uint64_t rehash_ns;                   /* total time spent rehashing keys (nanoseconds) */
+    StruktsHashmapOpCounters op_counters; /* updated atomically (relaxed) by concurrent readers */
+};
+
+/**
+ * A snapshot of the occupancy of a hash map: @see strukts_hashmap_stats.
+ */
+typedef struct _StruktsHashmapStats StruktsHashmapStats;
+
+struct _StruktsHashmapStats {
+    size_t size;            /* amount of keys */
+    size_t capacity;        /* amount of buckets (of both bucket arrays while rehashing) */
+    double load_factor;     /* size / capacity */
+    size_t empty_buckets;   /* amount of buckets without any entry */
+    size_t longest_chain;   /* amount of entries of the longest chain */
+    size_t rehashes;        /* amount of rehashings started */
+    uint64_t rehash_ns;     /* time spent rehashing (nanoseconds): @see strukts_hashmap_stats */
+    size_t allocated_bytes; /* bytes of the hash map, its buckets, entries, keys and filter */
+
+    /* chain_lengths[i]: amount of buckets whose chains have i entries (the last one: or more) */
+    size_t chain_lengths[STRUKTS_HASHMAP_STATS_CHAINS];
+    StruktsHashmapOpCounters op_counters; /* lookup counters (0 if compiled out) */
+};
+
+/**
+ * Iterator over all entries of a hash map (@see strukts_hashmap_iterator_init): fields are private.
+ */
+typedef struct _StruktsHashmapIterator StruktsHashmapIterator;
+
+struct _StruktsHashmapIterator {
+    const StruktsHashmap* hashmap;
+    StruktsHashmapEntry** buckets; /* bucket array being walked (old one first when rehashing) */
+    size_t capacity;               /* amount of buckets of the bucket array being walked */
+    size_t bucket;                 /* next bucket of the bucket array to be walked */
+    StruktsHashmapEntry* entry;    /* next entry of the current chain (NULL: next bucket) */
 };
 
 /**
@@ -45,6 +184,57 @@ struct _StruktsHashmap {
  */
 StruktsHashmap* strukts_hashmap_new();
 
+/**
+ * Allocates a new hash map, just like strukts_hashmap_new, whose behavior is customized by flags
+ * such as STRUKTS_HASHMAP_INCREMENTAL_REHASH, STRUKTS_HASHMAP_ARENA, STRUKTS_HASHMAP_SHRINK,
+ * STRUKTS_HASHMAP_OWN_KEYS or STRUKTS_HASHMAP_MURMUR3_128.
+ *
+ * @param flags is a bitwise or of STRUKTS_HASHMAP_* flags (or STRUKTS_HASHMAP_DEFAULT).
+ *
+ * @return a pointer to an empty hashmap.
+ */
+StruktsHashmap* strukts_hashmap_new_with_flags(unsigned int flags);
+
+/**
+ * Allocates a new hash map whose bucket array is already big enough to hold expected_keys keys
+ * without any rehashing: its capacity is the smallest power of 2 that keeps the load factor below
+ * STRUKTS_HASHMAP_MAX_LOAD_FACTOR (0.7) once all expected keys are added.
+ *
+ * @param expected_keys is the amount of keys expected to be added to the hash map.
+ *
+ * @return a pointer to an empty hashmap.
+ */
+StruktsHashmap* strukts_hashmap_new_with_capacity(size_t expected_keys);
+
+/**
+ * Allocates a new hash map sized for n keys and fills it with all keys/values in a single pass,
+ * without any rehashing. With more than one thread, the keys are hashed in slices by each thread,
+ * partitioned once by the slice of the bucket array they belong to and then each thread links only
+ * the keys of its own slice. Keys are not checked for duplicates (just like strukts_hashmap_add): a
+ * later duplicate shadows the value of an earlier one.
+ *
+ * @param keys is an array of n string keys.
+ * @param values is an array of n string values: values[i] is the value of keys[i].
+ * @param n is the amount of keys/values.
+ * @param threads_amount is the amount of threads used to build the hash map (0 or 1: no threads),
+ * up to STRUKTS_HASHMAP_BUILD_MAX_THREADS.
+ *
+ * @return a pointer to a hashmap with all keys/values; NULL if any allocation failed.
+ */
+StruktsHashmap* strukts_hashmap_build(const char* const keys[], char* const values[], size_t n,
+                                      size_t threads_amount);
+
+/**
+ * Grows the bucket array of the hash map (once) so that expected_keys keys fit without further
+ * rehashing. The bucket array never shrinks here.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param expected_keys is the total amount of keys expected to be in the hash map.
+ *
+ * @return true if the hash map can hold expected_keys keys without rehashing. False, otherwise.
+ */
+bool strukts_hashmap_reserve(StruktsHashmap* hashmap, size_t expected_keys);
+
 /**
  * Deallocates all memory previously allocated by the hashmap and its inner structures.
  *
@@ -52,29 +242,259 @@ StruktsHashmap* strukts_hashmap_new();
  */
 void strukts_hashmap_free(StruktsHashmap* hashmap);
 
+/**
+ * Hashes a key of key_len bytes just like the hash map's own operations do, for callers that need
+ * the hash before calling them, such as sharded hash maps that pick a shard from it (@see
+ * strukts_hashmap_get_hashed). The hash only depends on the hash map's flags.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return the key's hashes: the lower 32 bits are the key's hash (as in its entry) and the upper 32
+ * bits are the Bloom filters' second hash with STRUKTS_HASHMAP_MURMUR3_128 (0, otherwise).
+ */
+uint64_t strukts_hashmap_hash_key(const StruktsHashmap* hashmap, const void* key, size_t key_len);
+
 /**
  * Adds a new key (and its value) to a hash map. If the current load factor is bigger than
- * STRUKTS_HASHMAP_MAX_LOAD_FACTOR (0.7), a new hashmap with twice as much capacity (always a power
- * of 2) is allocated and all current keys/values are rehashed into the new hashmap dynamically.
- * Hence, the hashmap pointer can be mutated to point to a new bigger hashmap, if necessary.
+ * STRUKTS_HASHMAP_MAX_LOAD_FACTOR (0.7), a new bucket array with twice as much capacity (always a
+ * power of 2) is allocated and the current keys/values are rehashed into it: all at once or, with
+ * STRUKTS_HASHMAP_INCREMENTAL_REHASH, a few buckets per operation. Keys are not checked for
+ * duplicates: adding an existing key again shadows its previous value (@see strukts_hashmap_upsert
+ * to replace values of existing keys instead). The hashmap pointer itself never changes.
  *
- * @param hashmap is the address of a hashmap pointer.
+ * @param hashmap is a pointer to hashmap.
  * @param key is a pointer to a string key.
  * @param value is a pointer to a string value.
  *
  * @return true if the key/value has been added to the hashmap. False, otherwise.
  */
-bool strukts_hashmap_add(StruktsHashmap** hashmap, const char* key, char* value);
+bool strukts_hashmap_add(StruktsHashmap* hashmap, const char* key, char* value);
+
+/**
+ * Adds a new key of key_len bytes (which doesn't need to be NUL-terminated) and its value to a
+ * hash map. Works just like strukts_hashmap_add. The key's bytes are not copied: they must
+ * outlive their entry in the hash map.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added to the hashmap. False, otherwise.
+ */
+bool strukts_hashmap_add_n(StruktsHashmap* hashmap, const void* key, size_t key_len, char* value);
+
+/**
+ * Adds a new key (and its value) to a hash map or, if the key is already in the hash map, replaces
+ * its value in place (without adding a new entry). Rehashing works just like strukts_hashmap_add.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_hashmap_upsert(StruktsHashmap* hashmap, const char* key, char* value);
 
 /**
- * Searches for a given key in the hash map and returns its value if the key was found.
+ * Adds or replaces a key of key_len bytes and its value. Works just like strukts_hashmap_upsert.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_hashmap_upsert_n(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                              char* value);
+
+/**
+ * Adds or replaces a key of key_len bytes whose hashes were computed by strukts_hashmap_hash_key,
+ * so the key isn't hashed again. Works just like strukts_hashmap_upsert.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ * @param key_hashes is the key's hashes returned by strukts_hashmap_hash_key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_hashmap_upsert_hashed(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                   uint64_t key_hashes, char* value);
+
+/**
+ * Removes a key (and its value) from the hash map. If the key was added more than once with
+ * strukts_hashmap_add, only its newest value is removed. With STRUKTS_HASHMAP_SHRINK, the capacity
+ * is halved when the load factor drops below STRUKTS_HASHMAP_MIN_LOAD_FACTOR (0.1), but never
+ * below STRUKTS_HASHMAP_INITIAL_CAPACITY.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to a string key which will be removed from the hash map.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_hashmap_remove(StruktsHashmap* hashmap, const char* key);
+
+/**
+ * Removes a key of key_len bytes (and its value) from the hash map. Works just like
+ * strukts_hashmap_remove.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_hashmap_remove_n(StruktsHashmap* hashmap, const void* key, size_t key_len);
+
+/**
+ * Removes a key of key_len bytes whose hashes were computed by strukts_hashmap_hash_key, so the key
+ * isn't hashed again. Works just like strukts_hashmap_remove.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ * @param key_hashes is the key's hashes returned by strukts_hashmap_hash_key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_hashmap_remove_hashed(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                   uint64_t key_hashes);
+
+/**
+ * Searches for a given key in the hash map and returns its value if the key was found. If an
+ * incremental rehashing is in progress, a few buckets are migrated as well.
  *
  * @param hashmap is a pointer to hashmap.
  * @param key is a pointer to a string key which will be searched in the hash map.
  *
  * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
  */
-char* strukts_hashmap_get(const StruktsHashmap* hashmap, const char* key);
+char* strukts_hashmap_get(StruktsHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a key of key_len bytes in the hash map. Works just like strukts_hashmap_get.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_hashmap_get_n(StruktsHashmap* hashmap, const void* key, size_t key_len);
+
+/**
+ * Searches for a key of key_len bytes whose hashes were computed by strukts_hashmap_hash_key, so
+ * the key isn't hashed again. Works just like strukts_hashmap_get.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ * @param key_hashes is the key's hashes returned by strukts_hashmap_hash_key.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_hashmap_get_hashed(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                 uint64_t key_hashes);
+
+/**
+ * Searches for many keys in the hash map at once. Keys are processed in batches of
+ * STRUKTS_HASHMAP_GET_MANY_BATCH keys: all keys of a batch are hashed first and their buckets are
+ * prefetched, then their chains are walked in an interleaved way (one entry of each chain at a
+ * time, prefetching the next ones) so that the memory accesses of different keys overlap instead
+ * of stalling one after another.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param keys is an array of n string keys which will be searched in the hash map.
+ * @param n is the amount of keys.
+ * @param values is an array of n pointers filled with each key's value (NULL if not found).
+ *
+ * @return the amount of keys that were found in the hash map.
+ */
+size_t strukts_hashmap_get_many(StruktsHashmap* hashmap, const char* const keys[], size_t n,
+                                char* values[]);
+
+/**
+ * Initializes an iterator over all entries of the hash map. Entries are visited bucket by bucket,
+ * in the order of the bucket array in memory (the old bucket array first if an incremental
+ * rehashing is in progress). Keys added more than once with strukts_hashmap_add are visited once
+ * per entry. The hash map must not be modified (not even by strukts_hashmap_get, which may migrate
+ * buckets) while the iterator is used.
+ *
+ * @param iterator is a pointer to the iterator to initialize.
+ * @param hashmap is a pointer to hashmap.
+ */
+void strukts_hashmap_iterator_init(StruktsHashmapIterator* iterator, const StruktsHashmap* hashmap);
+
+/**
+ * Advances the iterator to the next entry of the hash map.
+ *
+ * @param iterator is a pointer to an initialized iterator.
+ *
+ * @return a pointer to the next entry (its key, key_len and value); NULL once all entries were
+ * visited.
+ */
+const StruktsHashmapEntry* strukts_hashmap_iterator_next(StruktsHashmapIterator* iterator);
+
+/**
+ * Visits all entries of one bucket (two or more buckets if an incremental rehashing is in progress)
+ * and returns the cursor of the next call. A full scan starts with the cursor 0 and ends when 0 is
+ * returned again. Cursors are incremented with their bits reversed (just like the SCAN command of
+ * Redis): since capacities are powers of 2, the buckets that were already visited are the same
+ * no matter whether the hash map has grown or shrunk between calls. Hence, every key which is in
+ * the hash map during the whole scan is visited at least once (keys may be visited more than once
+ * when the hash map shrinks). The hash map must not be modified by the visit function.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param cursor is 0 to start a scan or the cursor returned by the previous call.
+ * @param visit is the function called with each visited entry and the context.
+ * @param context is a pointer passed as is to the visit function.
+ *
+ * @return the cursor of the next call; 0 if the scan is over.
+ */
+uint64_t strukts_hashmap_scan(const StruktsHashmap* hashmap, uint64_t cursor,
+                              void (*visit)(const StruktsHashmapEntry*, void*), void* context);
+
+/**
+ * Creates a Bloom filter (@see strukts_bloom_filter_new) which is kept in front of the hash map:
+ * all current keys are added to it and so are all keys added later. Lookups (strukts_hashmap_get*)
+ * check the filter first, reusing the key's hash as the filter's first hash, and keys rejected by
+ * it return NULL without reading any bucket. The filter's second hash is the upper half of the
+ * key's 128-bit hash (STRUKTS_HASHMAP_MURMUR3_128) or, for 32-bit hashes, another murmur3 pass
+ * which is skipped when the first hash alone rejects the key. Removed keys stay in the filter (only
+ * adding to its false positives) and the filter never grows: it should be sized for the most keys
+ * the hash map will ever hold. An already attached filter is replaced. The filter is deallocated
+ * along with the hash map.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param expected_keys is the amount of keys expected to be in the hash map.
+ * @param false_positive_rate is the false positive rate of the filter, in (0, 1).
+ * @param bloom_flags is a bitwise or of STRUKTS_BLOOM_FILTER_* flags (such as
+ * STRUKTS_BLOOM_FILTER_BLOCKED). STRUKTS_BLOOM_FILTER_MURMUR3_128 is set only if the hash map was
+ * created with STRUKTS_HASHMAP_MURMUR3_128, so the filter hashes keys just like the hash map.
+ *
+ * @return true if the filter has been attached. False, otherwise (the hash map is left untouched).
+ */
+bool strukts_hashmap_attach_bloom_filter(StruktsHashmap* hashmap, size_t expected_keys,
+                                         double false_positive_rate, unsigned int bloom_flags);
+
+/**
+ * Computes the occupancy statistics of the hash map: its load factor, the histogram of its chain
+ * lengths, its longest chain and empty buckets (all buckets are walked: O(capacity + size)), the
+ * rehashing work done so far, the bytes allocated for it and its lookup counters. A skewed hash
+ * distribution shows up as long chains along with many empty buckets at a normal load factor.
+ * Only whole rehashings are timed (rehash_ns): the few buckets migrated by each operation during
+ * an incremental rehashing are only timed when compiled with STRUKTS_HASHMAP_OP_COUNTERS defined.
+ *
+ * @param hashmap is a pointer to hashmap.
+ *
+ * @return the statistics of the hash map.
+ */
+StruktsHashmapStats strukts_hashmap_stats(const StruktsHashmap* hashmap);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,140 @@
+/**
+ * @file strukts_hyperloglog.h
+ *
+ * @brief Module that contains a HyperLogLog implementation: a fixed size sketch that estimates the
+ * amount of distinct keys (cardinality) added to it, with a standard error of about
+ * 1.04 / sqrt(2^precision). To create a new empty HyperLogLog, @see strukts_hyperloglog_new.
+ *
+ * Each key is hashed to 64 bits (the lower half of its 128-bit murmur3 hash, @see
+ * strukts_murmur3_hash_x64_128): the hash's first precision bits pick one of 2^precision
+ * registers, which keeps the longest run of leading zeros (plus one) seen in the remaining bits.
+ * Adding a key that was already added never changes the sketch.
+ *
+ * A HyperLogLog starts with sparse registers: a sorted array of the few registers that are not
+ * zero, so sketches of small sets only take a few bytes. Once the sparse array would take as many
+ * bytes as the dense registers (one byte per register), it's converted to dense registers, whose
+ * size is fixed from then on (4 KB for the default precision).
+ *
+ * Sketches with the same precision can be merged (@see strukts_hyperloglog_merge): the merged
+ * sketch estimates the cardinality of the union of both sets of keys.
+ */
+
+#ifndef STRUKTS_HYPERLOGLOG_H
+#define STRUKTS_HYPERLOGLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_HYPERLOGLOG_MIN_PRECISION 4
+#define STRUKTS_HYPERLOGLOG_MAX_PRECISION 16
+#define STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION 12 /* 4096 registers: ~1.6% standard error */
+#define STRUKTS_HYPERLOGLOG_SEED 0 /* seed of the key hashes */
+
+/**
+ * Represents a HyperLogLog sketch.
+ */
+typedef struct _StruktsHyperLogLog StruktsHyperLogLog;
+
+struct _StruktsHyperLogLog {
+    unsigned int precision;     /* p: amount of hash bits that pick a register */
+    size_t registers_amount;    /* m = 2^p */
+    bool sparse;                /* whether the sparse array is used instead of registers */
+    uint32_t* sparse_registers; /* sorted index << 8 | value of the registers that aren't zero */
+    size_t sparse_amount;       /* amount of sparse registers */
+    size_t sparse_capacity;     /* amount of allocated sparse registers */
+    uint8_t* registers;         /* m dense registers (NULL while sparse) */
+};
+
+/**
+ * Allocates a new empty HyperLogLog with sparse registers.
+ *
+ * @param precision is the amount of hash bits that pick a register, from
+ * STRUKTS_HYPERLOGLOG_MIN_PRECISION to STRUKTS_HYPERLOGLOG_MAX_PRECISION (such as
+ * STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION).
+ *
+ * @return a pointer to an empty HyperLogLog; NULL if the precision is out of range or if any
+ * allocation failed.
+ */
+StruktsHyperLogLog* strukts_hyperloglog_new(unsigned int precision);
+
+/**
+ * Deallocates all memory previously allocated by the HyperLogLog.
+ *
+ * @param hll is the HyperLogLog to deallocate.
+ */
+void strukts_hyperloglog_free(StruktsHyperLogLog* hll);
+
+/**
+ * Adds a key to the HyperLogLog.
+ *
+ * @param hll is a pointer to a HyperLogLog.
+ * @param key is a pointer to a string key.
+ *
+ * @return true if the key was added; false if converting to dense registers failed.
+ */
+bool strukts_hyperloglog_add(StruktsHyperLogLog* hll, const char* key);
+
+/**
+ * Adds a key of key_len bytes to the HyperLogLog. Works just like strukts_hyperloglog_add.
+ *
+ * @param hll is a pointer to a HyperLogLog.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return true if the key was added; false if converting to dense registers failed.
+ */
+bool strukts_hyperloglog_add_n(StruktsHyperLogLog* hll, const void* key, size_t key_len);
+
+/**
+ * Adds a key to the HyperLogLog given its 64-bit hash, for callers that have already hashed the
+ * key. The hash's bits must be uniformly distributed.
+ *
+ * @param hll is a pointer to a HyperLogLog.
+ * @param hash is the 64-bit hash of the key.
+ *
+ * @return true if the key was added; false if converting to dense registers failed.
+ */
+bool strukts_hyperloglog_add_hash(StruktsHyperLogLog* hll, uint64_t hash);
+
+/**
+ * Adds n keys to the HyperLogLog. Works just like calling strukts_hyperloglog_add for each key.
+ *
+ * @param hll is a pointer to a HyperLogLog.
+ * @param keys is an array of n string keys.
+ * @param n is the amount of keys.
+ *
+ * @return true if all keys were added; false if converting to dense registers failed.
+ */
+bool strukts_hyperloglog_add_many(StruktsHyperLogLog* hll, const char* const keys[], size_t n);
+
+/**
+ * Estimates the amount of distinct keys added to the HyperLogLog.
+ *
+ * @param hll is a pointer to a HyperLogLog.
+ *
+ * @return the estimated cardinality.
+ */
+uint64_t strukts_hyperloglog_count(const StruktsHyperLogLog* hll);
+
+/**
+ * Merges a HyperLogLog into another one: each register of dest becomes the greatest of its value
+ * and the value of the same register of src. Afterwards, dest estimates the cardinality of the
+ * union of the keys added to both sketches. The src sketch is not modified.
+ *
+ * @param dest is a pointer to the HyperLogLog that is merged into.
+ * @param src is a pointer to the HyperLogLog that is merged.
+ *
+ * @return true if the sketches were merged; false if their precisions differ or if converting to
+ * dense registers failed.
+ */
+bool strukts_hyperloglog_merge(StruktsHyperLogLog* dest, const StruktsHyperLogLog* src);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_HYPERLOGLOG_H */
@@ -0,0 +1,113 @@
+/**
+ * @file strukts_intmap.h
+ *
+ * @brief Module that contains a hash map specialized for 64-bit integer keys (such as IDs). To
+ * create a new empty integer map, @see strukts_intmap_new.
+ *
+ * Unlike the string keyed hash maps, keys are stored inline in the slots of a flat array, hashed
+ * by a single multiply-xorshift mixer instead of murmur3 over bytes and compared as integers: no
+ * string conversions, strlen or strcmp calls. Collisions are resolved with linear probing and
+ * removals shift the following keys backwards, so no tombstones are ever left behind.
+ *
+ * The key 0 marks empty slots, so it's stored apart from the slots (it's still a valid key).
+ */
+
+#ifndef STRUKTS_INTMAP_H
+#define STRUKTS_INTMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_INTMAP_INITIAL_CAPACITY 16
+#define STRUKTS_INTMAP_MAX_LOAD_FACTOR 0.7
+
+/**
+ * A slot of the integer map: the key 0 marks an empty slot.
+ */
+typedef struct _StruktsIntmapSlot StruktsIntmapSlot;
+
+struct _StruktsIntmapSlot {
+    uint64_t key;
+    char* value;
+};
+
+/**
+ * Represents a hash map of 64-bit integer keys.
+ */
+typedef struct _StruktsIntmap StruktsIntmap;
+
+struct _StruktsIntmap {
+    size_t size;              /* amount of keys so far (including the key 0) */
+    size_t capacity;          /* amount of slots: always a power of 2 */
+    StruktsIntmapSlot* slots; /* flat array of key/value slots */
+    bool has_zero_key;        /* whether the key 0 is in the map */
+    char* zero_value;         /* value of the key 0 */
+};
+
+/**
+ * Allocates a new integer map whose initial capacity (amount of slots) is
+ * STRUKTS_INTMAP_INITIAL_CAPACITY (16).
+ *
+ * @return a pointer to an empty integer map; NULL if any allocation failed.
+ */
+StruktsIntmap* strukts_intmap_new();
+
+/**
+ * Deallocates all memory previously allocated by the integer map.
+ *
+ * @param intmap is the integer map to deallocate.
+ */
+void strukts_intmap_free(StruktsIntmap* intmap);
+
+/**
+ * Adds a new key (and its value) to the integer map or replaces the value of an existing key. If
+ * the load factor would become bigger than STRUKTS_INTMAP_MAX_LOAD_FACTOR (0.7), the slots are
+ * reallocated with twice as much capacity. The intmap pointer itself never changes.
+ *
+ * @param intmap is a pointer to an integer map.
+ * @param key is a 64-bit integer key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_intmap_upsert(StruktsIntmap* intmap, uint64_t key, char* value);
+
+/**
+ * Removes a key (and its value) from the integer map by shifting the following keys backwards.
+ *
+ * @param intmap is a pointer to an integer map.
+ * @param key is a 64-bit integer key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_intmap_remove(StruktsIntmap* intmap, uint64_t key);
+
+/**
+ * Searches for a given key in the integer map and returns its value if the key was found.
+ *
+ * @param intmap is a pointer to an integer map.
+ * @param key is a 64-bit integer key which will be searched in the map.
+ *
+ * @return the key's value if the key was found in the map; NULL, otherwise.
+ */
+char* strukts_intmap_get(const StruktsIntmap* intmap, uint64_t key);
+
+/**
+ * Checks whether a given key is in the integer map (even if its value is NULL).
+ *
+ * @param intmap is a pointer to an integer map.
+ * @param key is a 64-bit integer key which will be searched in the map.
+ *
+ * @return true if the key is in the map. False, otherwise.
+ */
+bool strukts_intmap_contains(const StruktsIntmap* intmap, uint64_t key);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_INTMAP_H */
@@ -119,6 +119,23 @@ bool strukts_linkedlist_remove_last(StruktsLinkedList* list);
  */
 bool strukts_linkedlist_remove(StruktsLinkedList* list, const char* key);
 
+/**
+ * Removes a given node from the doubly linked list in O(1), without searching for it.
+ *
+ * @param list is the linked list which will have the node removed.
+ * @param node is a node that belongs to the list.
+ */
+void strukts_linkedlist_remove_node(StruktsLinkedList* list, StruktsLinkedListNode* node);
+
+/**
+ * Moves a given node to the beginning of the doubly linked list in O(1) by relinking it (the node
+ * is neither reallocated nor copied).
+ *
+ * @param list is the linked list which contains the node.
+ * @param node is a node that belongs to the list.
+ */
+void strukts_linkedlist_move_to_front(StruktsLinkedList* list, StruktsLinkedListNode* node);
+
 /**
  * Traverses the linked list trying to find a value by its key.
  *
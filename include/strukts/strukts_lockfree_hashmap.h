@@ -0,0 +1,153 @@
+/**
+ * @file strukts_lockfree_hashmap.h
+ *
+ * @brief Module that contains a hash map for read-mostly workloads whose lookups are lock-free.
+ * To create a new empty lock-free hash map, @see strukts_lockfree_hashmap_new.
+ *
+ * Lookups take no locks and do no atomic read-modify-write operations: they only announce an
+ * epoch (@see strukts_epoch.h) and follow pointers with acquire loads. Writers are serialized by a
+ * mutex and publish new nodes, buckets and whole bucket arrays with release stores, so they never
+ * block readers (not even while resizing). Nodes are immutable once published: replacing a value
+ * publishes a new node. Unlinked nodes and bucket arrays replaced by a resize are retired and
+ * deallocated through epoch-based reclamation once no reader can reach them anymore.
+ */
+
+#ifndef STRUKTS_LOCKFREE_HASHMAP_H
+#define STRUKTS_LOCKFREE_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "strukts_epoch.h"
+
+#define STRUKTS_LOCKFREE_HASHMAP_INITIAL_CAPACITY 8
+#define STRUKTS_LOCKFREE_HASHMAP_MAX_LOAD_FACTOR 0.7
+
+/**
+ * A node of a bucket's chain. Its key is copied into the node (right after it), so that readers
+ * still holding a retired node never read memory that the caller has already released.
+ */
+typedef struct _StruktsLockFreeHashmapNode StruktsLockFreeHashmapNode;
+
+struct _StruktsLockFreeHashmapNode {
+    StruktsLockFreeHashmapNode* next; /* accessed with atomic loads/stores only */
+    char* value;
+    size_t key_len;
+    uint32_t hash;
+    char key[]; /* null terminated copy of the key */
+};
+
+/**
+ * A bucket array: replaced as a whole (and retired) when the hash map resizes.
+ */
+typedef struct _StruktsLockFreeHashmapTable StruktsLockFreeHashmapTable;
+
+struct _StruktsLockFreeHashmapTable {
+    size_t capacity;                      /* amount of buckets: always a power of 2 */
+    StruktsLockFreeHashmapNode** buckets; /* accessed with atomic loads/stores only */
+};
+
+/**
+ * Represents a hash map with lock-free lookups and mutex-serialized writers.
+ */
+typedef struct _StruktsLockFreeHashmap StruktsLockFreeHashmap;
+
+struct _StruktsLockFreeHashmap {
+    StruktsLockFreeHashmapTable* table; /* accessed with atomic loads/stores only */
+    size_t size;                        /* amount of keys: guarded by the writer lock */
+    pthread_mutex_t writer_lock;        /* serializes writers and reader (un)registrations */
+    StruktsEpochDomain* epoch;          /* reclaims retired nodes and tables */
+};
+
+/**
+ * Allocates a new empty lock-free hash map.
+ *
+ * @param max_readers is the maximum amount of concurrently registered reader threads.
+ *
+ * @return a pointer to an empty lock-free hash map; NULL if any allocation failed.
+ */
+StruktsLockFreeHashmap* strukts_lockfree_hashmap_new(size_t max_readers);
+
+/**
+ * Deallocates all memory previously allocated by the hash map (including retired nodes and tables).
+ * No other thread may be using the hash map.
+ *
+ * @param hashmap is the lock-free hash map to deallocate.
+ */
+void strukts_lockfree_hashmap_free(StruktsLockFreeHashmap* hashmap);
+
+/**
+ * Registers the calling thread as a reader of the hash map: each reader thread needs its own
+ * reader handle to call strukts_lockfree_hashmap_get.
+ *
+ * @param hashmap is a pointer to a lock-free hash map.
+ *
+ * @return a reader handle; NULL if max_readers threads are already registered.
+ */
+StruktsEpochReader* strukts_lockfree_hashmap_reader_register(StruktsLockFreeHashmap* hashmap);
+
+/**
+ * Releases a reader handle previously returned by strukts_lockfree_hashmap_reader_register.
+ *
+ * @param hashmap is a pointer to a lock-free hash map.
+ * @param reader is the reader handle to release.
+ */
+void strukts_lockfree_hashmap_reader_unregister(StruktsLockFreeHashmap* hashmap,
+                                                StruktsEpochReader* reader);
+
+/**
+ * Adds or replaces a key (and its value) in the hash map. The key is copied by the hash map whereas
+ * the value is only referenced: it must stay valid while readers may still return it.
+ *
+ * @param hashmap is a pointer to a lock-free hash map.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_lockfree_hashmap_upsert(StruktsLockFreeHashmap* hashmap, const char* key,
+                                     char* value);
+
+/**
+ * Removes a key (and its value) from the hash map. Its node is reclaimed once no reader can
+ * reach it anymore.
+ *
+ * @param hashmap is a pointer to a lock-free hash map.
+ * @param key is a pointer to a string key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_lockfree_hashmap_remove(StruktsLockFreeHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a given key in the hash map without taking locks or doing atomic read-modify-write
+ * operations: it never blocks, not even while a writer resizes the hash map.
+ *
+ * @param hashmap is a pointer to a lock-free hash map.
+ * @param reader is the reader handle of the calling thread.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_lockfree_hashmap_get(StruktsLockFreeHashmap* hashmap, StruktsEpochReader* reader,
+                                   const char* key);
+
+/**
+ * Gets the amount of keys in the hash map.
+ *
+ * @param hashmap is a pointer to a lock-free hash map.
+ *
+ * @return the amount of keys in the hash map.
+ */
+size_t strukts_lockfree_hashmap_size(StruktsLockFreeHashmap* hashmap);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_LOCKFREE_HASHMAP_H */
@@ -0,0 +1,110 @@
+/**
+ * @file strukts_lrucache.h
+ *
+ * @brief Module that contains a bounded least recently used (LRU) cache. To create a new empty
+ * LRU cache, @see strukts_lrucache_new.
+ *
+ * The cache keeps its entries in a doubly linked list ordered by recency (@see
+ * strukts_linkedlist.h): the most recently used entry is the first node and the least recently
+ * used one is the last node. A hash map (@see strukts_hashmap.h) maps each key to its list node,
+ * so lookups, moving a hit entry to the front and evicting from the tail are all O(1).
+ *
+ * A cache can be bounded by its amount of entries, by its amount of bytes or by both. The bytes of
+ * an entry are the lengths of its key and value strings. Hits, misses and evictions are counted so
+ * that the cache can be sized from real workloads.
+ */
+
+#ifndef STRUKTS_LRUCACHE_H
+#define STRUKTS_LRUCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "strukts_hashmap.h"
+#include "strukts_linkedlist.h"
+
+/**
+ * Represents a bounded LRU cache of string keys and string values.
+ */
+typedef struct _StruktsLRUCache StruktsLRUCache;
+
+struct _StruktsLRUCache {
+    size_t max_entries;         /* maximum amount of entries: 0 for no entries limit */
+    size_t max_bytes;           /* maximum amount of bytes: 0 for no bytes limit */
+    size_t bytes;               /* current amount of bytes of all entries */
+    uint64_t hits;              /* lookups that found their key */
+    uint64_t misses;            /* lookups that didn't find their key */
+    uint64_t evictions;         /* entries evicted to respect the limits */
+    StruktsHashmap* index;      /* maps keys to their nodes in the recency list */
+    StruktsLinkedList* recency; /* entries from the most to the least recently used */
+};
+
+/**
+ * Allocates a new empty LRU cache bounded by max_entries entries and/or max_bytes bytes.
+ *
+ * @param max_entries is the maximum amount of entries (0 for no entries limit).
+ * @param max_bytes is the maximum sum of the key and value lengths (0 for no bytes limit).
+ *
+ * @return a pointer to an empty LRU cache; NULL if both limits are 0 or any allocation failed.
+ */
+StruktsLRUCache* strukts_lrucache_new(size_t max_entries, size_t max_bytes);
+
+/**
+ * Deallocates all memory previously allocated by the LRU cache. Keys and values are not
+ * deallocated as they're owned by the caller.
+ *
+ * @param cache is the LRU cache to deallocate.
+ */
+void strukts_lrucache_free(StruktsLRUCache* cache);
+
+/**
+ * Adds or replaces a key (and its value) as the most recently used entry of the cache. Least
+ * recently used entries are evicted until the cache respects its limits again.
+ *
+ * @param cache is a pointer to an LRU cache.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced; false if the entry alone exceeds the
+ * cache's max_bytes or an allocation failed.
+ */
+bool strukts_lrucache_put(StruktsLRUCache* cache, const char* key, char* value);
+
+/**
+ * Searches for a key in the cache. On a hit, the key becomes the most recently used entry.
+ *
+ * @param cache is a pointer to an LRU cache.
+ * @param key is a pointer to a string key which will be searched in the cache.
+ *
+ * @return a pointer to the key's value if the key was found in the cache; NULL, otherwise.
+ */
+char* strukts_lrucache_get(StruktsLRUCache* cache, const char* key);
+
+/**
+ * Removes a key (and its value) from the cache. Removals are not counted as evictions.
+ *
+ * @param cache is a pointer to an LRU cache.
+ * @param key is a pointer to a string key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_lrucache_remove(StruktsLRUCache* cache, const char* key);
+
+/**
+ * Gets the amount of entries in the cache.
+ *
+ * @param cache is a pointer to an LRU cache.
+ *
+ * @return the amount of entries in the cache.
+ */
+size_t strukts_lrucache_size(const StruktsLRUCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_LRUCACHE_H */
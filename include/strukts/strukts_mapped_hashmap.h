@@ -0,0 +1,140 @@
+/**
+ * @file strukts_mapped_hashmap.h
+ *
+ * @brief Module that contains a read-only hash map served straight from a memory mapped file. To
+ * save a hash map to a file, @see strukts_mapped_hashmap_write. To load it, @see
+ * strukts_mapped_hashmap_open.
+ *
+ * The file holds a header, an open addressing (linear probing) array of slots and a blob with the
+ * keys and values (NUL-terminated) of all slots. Slots refer to the blob by file offsets instead of
+ * pointers, so the file is position-independent: it is mapped as is and lookups read the mapped
+ * pages directly, without any deserialization. Opening a file costs a few system calls no matter
+ * how many keys it has, and processes that map the same file share its pages in the page cache.
+ *
+ * Integers are stored in the byte order of the machine that wrote the file: files can only be
+ * opened on machines with the same byte order (which is checked by strukts_mapped_hashmap_open).
+ */
+
+#ifndef STRUKTS_MAPPED_HASHMAP_H
+#define STRUKTS_MAPPED_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "strukts_hashmap.h"
+
+#define STRUKTS_MAPPED_HASHMAP_MAGIC "STRUKTSM" /* first 8 bytes of every file */
+#define STRUKTS_MAPPED_HASHMAP_VERSION 1
+#define STRUKTS_MAPPED_HASHMAP_BYTE_ORDER 0x01020304u /* reads differently on other byte orders */
+#define STRUKTS_MAPPED_HASHMAP_MAX_LOAD_FACTOR 0.7
+
+/**
+ * Header at the beginning of a mapped hash map file (64 bytes).
+ */
+typedef struct _StruktsMappedHashmapHeader StruktsMappedHashmapHeader;
+
+struct _StruktsMappedHashmapHeader {
+    char magic[8];         /* STRUKTS_MAPPED_HASHMAP_MAGIC (without NUL) */
+    uint32_t version;      /* STRUKTS_MAPPED_HASHMAP_VERSION */
+    uint32_t byte_order;   /* STRUKTS_MAPPED_HASHMAP_BYTE_ORDER as written by the writer */
+    uint64_t size;         /* amount of keys */
+    uint64_t slots_amount; /* amount of slots (any amount: not necessarily a power of 2) */
+    uint64_t slots_offset; /* file offset of the slot array */
+    uint64_t blob_offset;  /* file offset of the keys/values blob */
+    uint64_t blob_bytes;   /* amount of bytes of the blob */
+    uint64_t hash_flags;   /* STRUKTS_HASHMAP_MURMUR3_128 if slots keep 128-bit murmur3 hashes */
+};
+
+/**
+ * A slot of a mapped hash map file: a key_offset of 0 marks an empty slot.
+ */
+typedef struct _StruktsMappedHashmapSlot StruktsMappedHashmapSlot;
+
+struct _StruktsMappedHashmapSlot {
+    uint64_t key_offset;   /* file offset of the key's bytes (followed by a NUL) */
+    uint64_t value_offset; /* file offset of the value's string; 0 for NULL values */
+    uint32_t hash;         /* murmur3 hash of the key (the same one of the saved StruktsHashmap) */
+    uint32_t key_len;      /* amount of bytes of the key */
+};
+
+/**
+ * Represents a read-only hash map whose slots and keys/values live in a memory mapped file.
+ */
+typedef struct _StruktsMappedHashmap StruktsMappedHashmap;
+
+struct _StruktsMappedHashmap {
+    size_t size;                           /* amount of keys */
+    size_t slots_amount;                   /* amount of slots */
+    const StruktsMappedHashmapSlot* slots; /* mapped slot array */
+    const char* file;                      /* first byte of the mapped file */
+    size_t file_bytes;                     /* amount of mapped bytes */
+    unsigned int hash_flags;               /* hash_flags of the file's header */
+};
+
+/**
+ * Saves all keys/values of a hash map to a file which can be memory mapped by
+ * strukts_mapped_hashmap_open. Values are saved as strings (up to their NUL). Keys added more than
+ * once with strukts_hashmap_add are saved once, with their newest value. The file is first written
+ * to path + ".tmp" and then renamed to path, so processes that have mapped a previous version of
+ * the file keep reading it safely.
+ *
+ * @param hashmap is a pointer to hashmap.
+ * @param path is the path of the file.
+ *
+ * @return true if the file has been written. False, otherwise (no file is left behind).
+ */
+bool strukts_mapped_hashmap_write(const StruktsHashmap* hashmap, const char* path);
+
+/**
+ * Memory maps (read-only and shared) a file written by strukts_mapped_hashmap_write. Only its
+ * header is read: pages of the slots and keys/values are loaded on demand by lookups.
+ *
+ * @param path is the path of the file.
+ *
+ * @return a pointer to a read-only hash map; NULL if the file could not be mapped or if it is not
+ * a valid mapped hash map file (of this version and byte order).
+ */
+StruktsMappedHashmap* strukts_mapped_hashmap_open(const char* path);
+
+/**
+ * Unmaps the file of the mapped hash map and deallocates it. Values returned by lookups can't be
+ * used after the hash map is closed.
+ *
+ * @param hashmap is the mapped hash map to close.
+ */
+void strukts_mapped_hashmap_close(StruktsMappedHashmap* hashmap);
+
+/**
+ * Searches for a given key in the mapped hash map.
+ *
+ * @param hashmap is a pointer to a mapped hash map.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value (inside the mapped file) if the key was found; NULL,
+ * otherwise.
+ */
+const char* strukts_mapped_hashmap_get(const StruktsMappedHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a key of key_len bytes in the mapped hash map. Works just like
+ * strukts_mapped_hashmap_get.
+ *
+ * @param hashmap is a pointer to a mapped hash map.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return a pointer to the key's value (inside the mapped file) if the key was found; NULL,
+ * otherwise.
+ */
+const char* strukts_mapped_hashmap_get_n(const StruktsMappedHashmap* hashmap, const void* key,
+                                         size_t key_len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_MAPPED_HASHMAP_H */
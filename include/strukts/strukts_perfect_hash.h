@@ -0,0 +1,102 @@
+/**
+ * @file strukts_perfect_hash.h
+ *
+ * @brief Module that contains a minimal perfect hash function builder for static sets of keys: n
+ * distinct keys are mapped to the indexes [0, n) without any collisions. To build one, @see
+ * strukts_perfect_hash_build.
+ *
+ * The construction follows BBHash: each level is a bit array with gamma bits per remaining key.
+ * Every key is hashed (murmur3 seeded by the level) to a bit of the level: keys that land on a bit
+ * alone set it, and keys that collide with others are retried by the next, smaller, level. The
+ * index of a key is the rank of its bit (amount of set bits before it) over all levels, answered in
+ * constant time by a directory of cumulative popcounts. With a gamma of 2, about 61% of the keys
+ * are placed by the first level (a single hash) and the whole function takes about 4 bits per key.
+ */
+
+#ifndef STRUKTS_PERFECT_HASH_H
+#define STRUKTS_PERFECT_HASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_PERFECT_HASH_GAMMA 2.0      /* bits of a level per key still to be placed */
+#define STRUKTS_PERFECT_HASH_MAX_LEVELS 32  /* keys not placed by the last level fail the build */
+#define STRUKTS_PERFECT_HASH_RANK_WORDS 8   /* 64-bit words per rank directory block (512 bits) */
+#define STRUKTS_PERFECT_HASH_NOT_FOUND SIZE_MAX
+
+/**
+ * Represents a minimal perfect hash function of a static set of keys.
+ */
+typedef struct _StruktsPerfectHash StruktsPerfectHash;
+
+struct _StruktsPerfectHash {
+    size_t keys_amount;                                   /* n: keys are mapped to [0, n) */
+    size_t levels_amount;                                 /* amount of levels used by the keys */
+    size_t level_bits[STRUKTS_PERFECT_HASH_MAX_LEVELS];   /* bits of each level (multiple of 64) */
+    size_t level_offset[STRUKTS_PERFECT_HASH_MAX_LEVELS]; /* first bit of each level in bits */
+    size_t words_amount;                                  /* 64-bit words of all levels */
+    uint64_t* bits;                                       /* bit arrays of all levels, in order */
+    uint64_t* ranks;                                      /* set bits before each 512-bit block */
+};
+
+/**
+ * Builds a minimal perfect hash function of n distinct keys. The keys are not kept by the function.
+ *
+ * @param keys is an array of n distinct string keys.
+ * @param n is the amount of keys.
+ *
+ * @return a pointer to the perfect hash function; NULL if any allocation failed or if some keys
+ * could not be placed by STRUKTS_PERFECT_HASH_MAX_LEVELS levels (such as with duplicate keys).
+ */
+StruktsPerfectHash* strukts_perfect_hash_build(const char* const keys[], size_t n);
+
+/**
+ * Deallocates all memory previously allocated by the perfect hash function.
+ *
+ * @param perfect_hash is the perfect hash function to deallocate.
+ */
+void strukts_perfect_hash_free(StruktsPerfectHash* perfect_hash);
+
+/**
+ * Computes the index of a key. Keys of the built set get distinct indexes in [0, n). Keys that are
+ * not in the set get either STRUKTS_PERFECT_HASH_NOT_FOUND or any index: membership must be checked
+ * by the caller (such as by comparing with the key stored at that index).
+ *
+ * @param perfect_hash is a pointer to a perfect hash function.
+ * @param key is a pointer to a string key.
+ *
+ * @return the index of the key; STRUKTS_PERFECT_HASH_NOT_FOUND if the key is surely not in the set.
+ */
+size_t strukts_perfect_hash_index(const StruktsPerfectHash* perfect_hash, const char* key);
+
+/**
+ * Computes the index of a key of key_len bytes. Works just like strukts_perfect_hash_index.
+ *
+ * @param perfect_hash is a pointer to a perfect hash function.
+ * @param key is a pointer to the key's bytes.
+ * @param key_len is the amount of bytes of the key.
+ *
+ * @return the index of the key; STRUKTS_PERFECT_HASH_NOT_FOUND if the key is surely not in the set.
+ */
+size_t strukts_perfect_hash_index_n(const StruktsPerfectHash* perfect_hash, const void* key,
+                                    size_t key_len);
+
+/**
+ * Computes the memory used by the perfect hash function per key: its level bits and its rank
+ * directory.
+ *
+ * @param perfect_hash is a pointer to a perfect hash function.
+ *
+ * @return the amount of bits per key (0 for an empty set of keys).
+ */
+double strukts_perfect_hash_bits_per_key(const StruktsPerfectHash* perfect_hash);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_PERFECT_HASH_H */
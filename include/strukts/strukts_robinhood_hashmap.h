@@ -0,0 +1,126 @@
+/**
+ * @file strukts_robinhood_hashmap.h
+ *
+ * @brief Module that contains a "Robin Hood" open addressing hash map implementation. To create a
+ * new empty Robin Hood hash map, @see strukts_robinhood_hashmap_new.
+ *
+ * Keys are placed with linear probing from their home slot (taken from their murmur3 hash). When
+ * a key being inserted is further from its home slot than the key of the slot it probes, it takes
+ * that slot ("robs the rich") and the displaced key continues probing instead. This keeps the
+ * probe lengths of all keys close to each other, so lookups remain short even at high load factors
+ * and missing keys are detected as soon as a slot closer to its home than the probe is found.
+ *
+ * Removals use backward shifting: the keys that follow the removed one are moved one slot back
+ * towards their home slots, so no tombstones are ever left behind.
+ */
+
+#ifndef STRUKTS_ROBINHOOD_HASHMAP_H
+#define STRUKTS_ROBINHOOD_HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define STRUKTS_ROBINHOOD_HASHMAP_INITIAL_CAPACITY 16
+#define STRUKTS_ROBINHOOD_HASHMAP_MAX_LOAD_FACTOR 0.9
+
+/**
+ * A slot of the Robin Hood hash map which holds a key, its value and its distance to its home slot.
+ */
+typedef struct _StruktsRobinHoodHashmapSlot StruktsRobinHoodHashmapSlot;
+
+struct _StruktsRobinHoodHashmapSlot {
+    const char* key; /* 'id' for the values, should not be mutated */
+    char* value;
+    uint32_t hash;     /* murmur3 hash of the key: resizing never hashes keys again */
+    uint32_t distance; /* probe length + 1: 0 for empty slots and 1 for keys in their home slot */
+};
+
+/**
+ * Represents a hash map that uses Robin Hood linear probing to deal with hashing collisions.
+ */
+typedef struct _StruktsRobinHoodHashmap StruktsRobinHoodHashmap;
+
+struct _StruktsRobinHoodHashmap {
+    size_t size;                        /* amount of keys so far */
+    size_t capacity;                    /* amount of slots: always a power of 2 */
+    StruktsRobinHoodHashmapSlot* slots; /* flat array of key/value slots */
+};
+
+/**
+ * Probe lengths of a Robin Hood hash map: how many slots after their home slots the keys are.
+ */
+typedef struct _StruktsRobinHoodHashmapProbeStats StruktsRobinHoodHashmapProbeStats;
+
+struct _StruktsRobinHoodHashmapProbeStats {
+    size_t max_probe_length;  /* longest probe length among all keys */
+    double mean_probe_length; /* average probe length of all keys (0 for empty hash maps) */
+};
+
+/**
+ * Allocates a new Robin Hood hash map whose initial capacity (amount of slots) is
+ * STRUKTS_ROBINHOOD_HASHMAP_INITIAL_CAPACITY (16).
+ *
+ * @return a pointer to an empty Robin Hood hash map; NULL if any allocation failed.
+ */
+StruktsRobinHoodHashmap* strukts_robinhood_hashmap_new();
+
+/**
+ * Deallocates all memory previously allocated by the Robin Hood hash map.
+ *
+ * @param hashmap is the Robin Hood hash map to deallocate.
+ */
+void strukts_robinhood_hashmap_free(StruktsRobinHoodHashmap* hashmap);
+
+/**
+ * Adds a new key (and its value) to the hash map or replaces the value of an existing key. If the
+ * load factor would become bigger than STRUKTS_ROBINHOOD_HASHMAP_MAX_LOAD_FACTOR (0.9), the slots
+ * are reallocated with twice as much capacity. The hashmap pointer itself never changes.
+ *
+ * @param hashmap is a pointer to a Robin Hood hash map.
+ * @param key is a pointer to a string key.
+ * @param value is a pointer to a string value.
+ *
+ * @return true if the key/value has been added or replaced. False, otherwise.
+ */
+bool strukts_robinhood_hashmap_upsert(StruktsRobinHoodHashmap* hashmap, const char* key,
+                                      char* value);
+
+/**
+ * Removes a key (and its value) from the hash map by shifting the following keys backwards.
+ *
+ * @param hashmap is a pointer to a Robin Hood hash map.
+ * @param key is a pointer to a string key.
+ *
+ * @return true if the key was found and removed. False, otherwise.
+ */
+bool strukts_robinhood_hashmap_remove(StruktsRobinHoodHashmap* hashmap, const char* key);
+
+/**
+ * Searches for a given key in the Robin Hood hash map and returns its value if the key was found.
+ *
+ * @param hashmap is a pointer to a Robin Hood hash map.
+ * @param key is a pointer to a string key which will be searched in the hash map.
+ *
+ * @return a pointer to the key's value if the key was found in the hash map; NULL, otherwise.
+ */
+char* strukts_robinhood_hashmap_get(const StruktsRobinHoodHashmap* hashmap, const char* key);
+
+/**
+ * Computes the maximum and mean probe lengths of the keys of the hash map by scanning its slots.
+ *
+ * @param hashmap is a pointer to a Robin Hood hash map.
+ *
+ * @return the probe length stats of the hash map.
+ */
+StruktsRobinHoodHashmapProbeStats strukts_robinhood_hashmap_probe_stats(
+    const StruktsRobinHoodHashmap* hashmap);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* STRUKTS_ROBINHOOD_HASHMAP_H */
@@ -0,0 +1,130 @@
+#include "strukts_arena.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline size_t align_up(size_t size)
+{
+    const size_t alignment = _Alignof(max_align_t);
+
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static inline size_t arena_slab_size(const StruktsArena* arena)
+{
+    const size_t alignment = STRUKTS_ARENA_CACHE_LINE;
+
+    /* over-allocates to align the slab's items to cache lines */
+    return align_up(sizeof(StruktsArenaSlab)) + alignment - 1 +
+           arena->slab_items * arena->item_size;
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static bool arena_new_slab(StruktsArena* arena)
+{
+    const size_t alignment = STRUKTS_ARENA_CACHE_LINE;
+    const size_t header_size = align_up(sizeof(StruktsArenaSlab));
+    StruktsArenaSlab* slab = (StruktsArenaSlab*)malloc(arena_slab_size(arena));
+
+    if (slab == NULL)
+        return false;
+
+    slab->next = arena->slabs;
+    arena->slabs = slab;
+    arena->slabs_amount++;
+
+    uintptr_t address = ((uintptr_t)slab + header_size + alignment - 1) & ~(alignment - 1);
+
+    /* items are handed out from the slab with a bump pointer */
+    arena->next_item = (char*)address;
+    arena->remaining_items = arena->slab_items;
+
+    return true;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsArena* strukts_arena_new(size_t item_size, size_t slab_items)
+{
+    if (item_size == 0 || slab_items == 0)
+        return NULL; /* impossible allocation */
+
+    StruktsArena* arena = (StruktsArena*)malloc(sizeof(StruktsArena));
+
+    if (arena == NULL)
+        return NULL;
+
+    /* released items store the free list's next pointer in their own bytes */
+    if (item_size < sizeof(void*))
+        item_size = sizeof(void*);
+
+    arena->item_size = align_up(item_size);
+    arena->slab_items = slab_items;
+    arena->slabs_amount = 0;
+    arena->slabs = NULL;
+    arena->free_list = NULL;
+    arena->next_item = NULL;
+    arena->remaining_items = 0;
+
+    return arena;
+}
+
+void strukts_arena_free(StruktsArena* arena)
+{
+    if (arena == NULL)
+        return;
+
+    StruktsArenaSlab* slab = arena->slabs;
+
+    /* one free per slab instead of one free per item */
+    while (slab != NULL) {
+        StruktsArenaSlab* next_slab = slab->next;
+
+        free(slab);
+        slab = next_slab;
+    }
+
+    free(arena);
+}
+
+void* strukts_arena_alloc(StruktsArena* arena)
+{
+    /* recycles released items first */
+    if (arena->free_list != NULL) {
+        void* item = arena->free_list;
+
+        arena->free_list = *(void**)item;
+
+        return item;
+    }
+
+    if (arena->remaining_items == 0 && !arena_new_slab(arena))
+        return NULL;
+
+    void* item = arena->next_item;
+
+    arena->next_item += arena->item_size;
+    arena->remaining_items--;
+
+    return item;
+}
+
+void strukts_arena_release(StruktsArena* arena, void* item)
+{
+    /* the released item becomes the new head of the free list */
+    *(void**)item = arena->free_list;
+    arena->free_list = item;
+}
+
+size_t strukts_arena_allocated_bytes(const StruktsArena* arena)
+{
+    return arena->slabs_amount * arena_slab_size(arena);
+}
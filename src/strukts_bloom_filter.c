@@ -0,0 +1,222 @@
+#include "strukts_bloom_filter.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define WORD_BITS 64
+#define CACHE_LINE 64
+#define BLOCK_WORDS (STRUKTS_BLOOM_FILTER_BLOCK_BITS / WORD_BITS)
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline size_t reduce(uint32_t hash, size_t n)
+{
+    /* maps the hash to [0, n) with a multiplication instead of a division */
+    return (size_t)(((uint64_t)hash * (uint64_t)n) >> 32);
+}
+
+static inline uint32_t block_delta(uint32_t alt_hash)
+{
+    /* rotated second hash: the increment between the bits of a key inside its block. It's forced
+     * odd, so the k bits of a key never cycle over fewer bits of the power of 2 sized block */
+    return ((alt_hash >> 17) | (alt_hash << 15)) | 1;
+}
+
+static inline void hash_key(const StruktsBloomFilter* filter, const void* key, size_t key_len,
+                            uint32_t* hash, uint32_t* alt_hash)
+{
+    const uint8_t* key_bytes = (const uint8_t*)key;
+
+    /* a single 128-bit hash yields both hashes: its lower and upper 64 bits */
+    if (filter->flags & STRUKTS_BLOOM_FILTER_MURMUR3_128) {
+        uint64_t hashes[2];
+
+        strukts_murmur3_hash_x64_128(key_bytes, key_len, STRUKTS_BLOOM_FILTER_SEED, hashes);
+        *hash = (uint32_t)hashes[0];
+        *alt_hash = (uint32_t)hashes[1];
+
+        return;
+    }
+
+    *hash = strukts_murmur3_hash(key_bytes, key_len, STRUKTS_BLOOM_FILTER_SEED);
+    *alt_hash = strukts_murmur3_hash(key_bytes, key_len, STRUKTS_BLOOM_FILTER_ALT_SEED);
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsBloomFilter* strukts_bloom_filter_new(size_t expected_keys, double false_positive_rate,
+                                             unsigned int flags)
+{
+    if (!(false_positive_rate > 0 && false_positive_rate < 1))
+        return NULL;
+
+    const double keys = expected_keys > 0 ? (double)expected_keys : 1;
+    const double ln2 = log(2);
+    const double bits = ceil(-keys * log(false_positive_rate) / (ln2 * ln2));
+    const size_t blocks_amount = (size_t)ceil(bits / STRUKTS_BLOOM_FILTER_BLOCK_BITS);
+
+    /* bit positions are reduced from 32-bit hashes */
+    if ((double)blocks_amount * STRUKTS_BLOOM_FILTER_BLOCK_BITS > (double)UINT32_MAX)
+        return NULL;
+
+    StruktsBloomFilter* filter = (StruktsBloomFilter*)malloc(sizeof(StruktsBloomFilter));
+
+    if (filter == NULL)
+        return NULL;
+
+    filter->blocks_amount = blocks_amount;
+    filter->bits_amount = blocks_amount * STRUKTS_BLOOM_FILTER_BLOCK_BITS;
+    filter->flags = flags;
+    filter->keys_amount = 0;
+
+    /* k = m / n * ln(2) minimizes the false positive rate for m bits and n keys */
+    long hashes_amount = lround((double)filter->bits_amount / keys * ln2);
+
+    if (hashes_amount < 1)
+        hashes_amount = 1;
+
+    if (hashes_amount > STRUKTS_BLOOM_FILTER_MAX_HASHES)
+        hashes_amount = STRUKTS_BLOOM_FILTER_MAX_HASHES;
+
+    filter->hashes_amount = (unsigned int)hashes_amount;
+
+    /* over-allocates one cache line so that every block starts on a cache line boundary */
+    const size_t words_bytes = filter->bits_amount / 8;
+
+    filter->words_memory = malloc(words_bytes + CACHE_LINE);
+
+    if (filter->words_memory == NULL) {
+        free(filter);
+
+        return NULL;
+    }
+
+    const uintptr_t address = (uintptr_t)filter->words_memory;
+
+    filter->words = (uint64_t*)((address + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1));
+    memset(filter->words, 0, words_bytes);
+
+    return filter;
+}
+
+void strukts_bloom_filter_free(StruktsBloomFilter* filter)
+{
+    if (filter == NULL)
+        return;
+
+    free(filter->words_memory);
+    free(filter);
+}
+
+void strukts_bloom_filter_add(StruktsBloomFilter* filter, const char* key)
+{
+    strukts_bloom_filter_add_n(filter, key, strlen(key));
+}
+
+void strukts_bloom_filter_add_n(StruktsBloomFilter* filter, const void* key, size_t key_len)
+{
+    uint32_t hash;
+    uint32_t alt_hash;
+
+    hash_key(filter, key, key_len, &hash, &alt_hash);
+    strukts_bloom_filter_add_hashes(filter, hash, alt_hash);
+}
+
+void strukts_bloom_filter_add_hashes(StruktsBloomFilter* filter, uint32_t hash, uint32_t alt_hash)
+{
+    filter->keys_amount++;
+
+    /* blocked layout: the first hash picks the block and the second one the bits inside of it */
+    if (filter->flags & STRUKTS_BLOOM_FILTER_BLOCKED) {
+        uint64_t* block = filter->words + reduce(hash, filter->blocks_amount) * BLOCK_WORDS;
+        const uint32_t delta = block_delta(alt_hash);
+
+        for (unsigned int i = 0; i < filter->hashes_amount; i++, alt_hash += delta) {
+            const uint32_t bit = alt_hash % STRUKTS_BLOOM_FILTER_BLOCK_BITS;
+
+            block[bit / WORD_BITS] |= 1ull << (bit % WORD_BITS);
+        }
+
+        return;
+    }
+
+    /* double hashing: the i-th bit of a key is h1 + i * h2 */
+    for (unsigned int i = 0; i < filter->hashes_amount; i++, hash += alt_hash) {
+        const size_t bit = reduce(hash, filter->bits_amount);
+
+        filter->words[bit / WORD_BITS] |= 1ull << (bit % WORD_BITS);
+    }
+}
+
+bool strukts_bloom_filter_might_contain(const StruktsBloomFilter* filter, const char* key)
+{
+    return strukts_bloom_filter_might_contain_n(filter, key, strlen(key));
+}
+
+bool strukts_bloom_filter_might_contain_n(const StruktsBloomFilter* filter, const void* key,
+                                          size_t key_len)
+{
+    uint32_t hash;
+    uint32_t alt_hash;
+
+    hash_key(filter, key, key_len, &hash, &alt_hash);
+
+    return strukts_bloom_filter_might_contain_hashes(filter, hash, alt_hash);
+}
+
+bool strukts_bloom_filter_might_contain_hashes(const StruktsBloomFilter* filter, uint32_t hash,
+                                               uint32_t alt_hash)
+{
+    if (filter->flags & STRUKTS_BLOOM_FILTER_BLOCKED) {
+        const uint64_t* block = filter->words + reduce(hash, filter->blocks_amount) * BLOCK_WORDS;
+        const uint32_t delta = block_delta(alt_hash);
+
+        for (unsigned int i = 0; i < filter->hashes_amount; i++, alt_hash += delta) {
+            const uint32_t bit = alt_hash % STRUKTS_BLOOM_FILTER_BLOCK_BITS;
+
+            if (!(block[bit / WORD_BITS] & (1ull << (bit % WORD_BITS))))
+                return false;
+        }
+
+        return true;
+    }
+
+    for (unsigned int i = 0; i < filter->hashes_amount; i++, hash += alt_hash) {
+        const size_t bit = reduce(hash, filter->bits_amount);
+
+        if (!(filter->words[bit / WORD_BITS] & (1ull << (bit % WORD_BITS))))
+            return false;
+    }
+
+    return true;
+}
+
+bool strukts_bloom_filter_might_contain_first_hash(const StruktsBloomFilter* filter,
+                                                   uint32_t hash)
+{
+    /* blocked layout: the first hash only picks the block, so just an empty block rejects keys */
+    if (filter->flags & STRUKTS_BLOOM_FILTER_BLOCKED) {
+        const uint64_t* block = filter->words + reduce(hash, filter->blocks_amount) * BLOCK_WORDS;
+        uint64_t bits = 0;
+
+        for (size_t w = 0; w < BLOCK_WORDS; w++)
+            bits |= block[w];
+
+        return bits != 0;
+    }
+
+    /* the first bit of a key (i = 0) only depends on h1 */
+    const size_t bit = reduce(hash, filter->bits_amount);
+
+    return (filter->words[bit / WORD_BITS] & (1ull << (bit % WORD_BITS))) != 0;
+}
@@ -0,0 +1,158 @@
+#include "strukts_concurrent_hashmap.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashmap.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define MAX_SHARD_BITS 16
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint64_t hash_key(const StruktsConcurrentHashmap* hashmap, const char* key,
+                                size_t key_len)
+{
+    /* all shards share the same flags, hence the same hashes */
+    return strukts_hashmap_hash_key(hashmap->shards[0].hashmap, key, key_len);
+}
+
+static inline StruktsConcurrentHashmapShard* shard_of(const StruktsConcurrentHashmap* hashmap,
+                                                      uint64_t key_hashes)
+{
+    if (hashmap->shard_bits == 0)
+        return &hashmap->shards[0];
+
+    /* high bits pick the shard whereas the shards' bucket arrays are indexed by the low bits */
+    return &hashmap->shards[(uint32_t)key_hashes >> (32 - hashmap->shard_bits)];
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsConcurrentHashmap* strukts_concurrent_hashmap_new(size_t shards_amount, unsigned int flags)
+{
+    const size_t alignment = STRUKTS_CONCURRENT_HASHMAP_CACHE_LINE;
+    unsigned int shard_bits = 0;
+
+    /* rounds the amount of shards up to a power of 2 */
+    while (((size_t)1 << shard_bits) < shards_amount && shard_bits < MAX_SHARD_BITS)
+        shard_bits++;
+
+    StruktsConcurrentHashmap* hashmap =
+        (StruktsConcurrentHashmap*)malloc(sizeof(StruktsConcurrentHashmap));
+
+    if (hashmap == NULL)
+        return NULL;
+
+    hashmap->shard_bits = shard_bits;
+    hashmap->shards_amount = (size_t)1 << shard_bits;
+
+    /* over-allocates to align the shards to cache lines: each shard's lock has its own line */
+    hashmap->shards_memory =
+        malloc(hashmap->shards_amount * sizeof(StruktsConcurrentHashmapShard) + alignment - 1);
+
+    if (hashmap->shards_memory == NULL) {
+        free(hashmap);
+
+        return NULL;
+    }
+
+    uintptr_t address = ((uintptr_t)hashmap->shards_memory + alignment - 1) & ~(alignment - 1);
+    hashmap->shards = (StruktsConcurrentHashmapShard*)address;
+
+    /* incremental rehashing migrates buckets on lookups which only hold read locks */
+    flags &= ~STRUKTS_HASHMAP_INCREMENTAL_REHASH;
+
+    for (size_t i = 0; i < hashmap->shards_amount; i++) {
+        StruktsConcurrentHashmapShard* shard = &hashmap->shards[i];
+
+        shard->hashmap = strukts_hashmap_new_with_flags(flags);
+
+        if (shard->hashmap == NULL || pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            /* deallocates the shards that have been fully initialized so far */
+            strukts_hashmap_free(shard->hashmap);
+            hashmap->shards_amount = i;
+            strukts_concurrent_hashmap_free(hashmap);
+
+            return NULL;
+        }
+    }
+
+    return hashmap;
+}
+
+void strukts_concurrent_hashmap_free(StruktsConcurrentHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    for (size_t i = 0; i < hashmap->shards_amount; i++) {
+        pthread_rwlock_destroy(&hashmap->shards[i].lock);
+        strukts_hashmap_free(hashmap->shards[i].hashmap);
+    }
+
+    free(hashmap->shards_memory);
+    free(hashmap);
+}
+
+bool strukts_concurrent_hashmap_upsert(StruktsConcurrentHashmap* hashmap, const char* key,
+                                       char* value)
+{
+    const size_t key_len = strlen(key);
+    const uint64_t key_hashes = hash_key(hashmap, key, key_len);
+    StruktsConcurrentHashmapShard* shard = shard_of(hashmap, key_hashes);
+
+    /* the key is hashed once: both to pick the shard and by the shard itself */
+    pthread_rwlock_wrlock(&shard->lock);
+    bool upserted = strukts_hashmap_upsert_hashed(shard->hashmap, key, key_len, key_hashes, value);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return upserted;
+}
+
+bool strukts_concurrent_hashmap_remove(StruktsConcurrentHashmap* hashmap, const char* key)
+{
+    const size_t key_len = strlen(key);
+    const uint64_t key_hashes = hash_key(hashmap, key, key_len);
+    StruktsConcurrentHashmapShard* shard = shard_of(hashmap, key_hashes);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    bool removed = strukts_hashmap_remove_hashed(shard->hashmap, key, key_len, key_hashes);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return removed;
+}
+
+char* strukts_concurrent_hashmap_get(StruktsConcurrentHashmap* hashmap, const char* key)
+{
+    const size_t key_len = strlen(key);
+    const uint64_t key_hashes = hash_key(hashmap, key, key_len);
+    StruktsConcurrentHashmapShard* shard = shard_of(hashmap, key_hashes);
+
+    /* shards never rehash incrementally, so lookups don't mutate them */
+    pthread_rwlock_rdlock(&shard->lock);
+    char* value = strukts_hashmap_get_hashed(shard->hashmap, key, key_len, key_hashes);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return value;
+}
+
+size_t strukts_concurrent_hashmap_size(StruktsConcurrentHashmap* hashmap)
+{
+    size_t size = 0;
+
+    for (size_t i = 0; i < hashmap->shards_amount; i++) {
+        pthread_rwlock_rdlock(&hashmap->shards[i].lock);
+        size += hashmap->shards[i].hashmap->size;
+        pthread_rwlock_unlock(&hashmap->shards[i].lock);
+    }
+
+    return size;
+}
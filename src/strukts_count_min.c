@@ -0,0 +1,147 @@
+#include "strukts_count_min.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define calloc sf_calloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define MAX_WIDTH ((size_t)1 << 31)
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline void counter_indexes(const StruktsCountMin* sketch, const void* key, size_t key_len,
+                                   size_t indexes[])
+{
+    uint64_t hashes[2];
+
+    strukts_murmur3_hash_x64_128((const uint8_t*)key, key_len, STRUKTS_COUNT_MIN_SEED, hashes);
+
+    /* an even h2 (such as 0) would pick correlated columns in the power of 2 wide rows */
+    uint32_t hash = (uint32_t)hashes[0];
+    const uint32_t alt_hash = (uint32_t)hashes[1] | 1;
+
+    for (size_t i = 0; i < sketch->depth; i++, hash += alt_hash)
+        indexes[i] = i * sketch->width + (hash & (sketch->width - 1));
+}
+
+static inline uint32_t min_counter(const StruktsCountMin* sketch, const size_t indexes[])
+{
+    uint32_t estimate = UINT32_MAX;
+
+    /* branchless min: the key's estimate is the smallest of its counters */
+    for (size_t i = 0; i < sketch->depth; i++) {
+        const uint32_t counter = sketch->counters[indexes[i]];
+
+        estimate = counter < estimate ? counter : estimate;
+    }
+
+    return estimate;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsCountMin* strukts_count_min_new(double epsilon, double delta)
+{
+    if (!(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1))
+        return NULL;
+
+    const double min_width = ceil(exp(1) / epsilon);
+
+    if (min_width > (double)MAX_WIDTH)
+        return NULL;
+
+    StruktsCountMin* sketch = (StruktsCountMin*)malloc(sizeof(StruktsCountMin));
+
+    if (sketch == NULL)
+        return NULL;
+
+    /* power of 2 widths turn the reduction of the hashes into a mask */
+    sketch->width = 1;
+
+    while ((double)sketch->width < min_width)
+        sketch->width <<= 1;
+
+    sketch->depth = (size_t)ceil(log(1 / delta));
+
+    if (sketch->depth < 1)
+        sketch->depth = 1;
+
+    if (sketch->depth > STRUKTS_COUNT_MIN_MAX_DEPTH)
+        sketch->depth = STRUKTS_COUNT_MIN_MAX_DEPTH;
+
+    sketch->total = 0;
+    sketch->counters = (uint32_t*)calloc(sketch->width * sketch->depth, sizeof(uint32_t));
+
+    if (sketch->counters == NULL) {
+        free(sketch);
+
+        return NULL;
+    }
+
+    return sketch;
+}
+
+void strukts_count_min_free(StruktsCountMin* sketch)
+{
+    if (sketch == NULL)
+        return;
+
+    free(sketch->counters);
+    free(sketch);
+}
+
+void strukts_count_min_add(StruktsCountMin* sketch, const char* key, uint32_t count)
+{
+    strukts_count_min_add_n(sketch, key, strlen(key), count);
+}
+
+void strukts_count_min_add_n(StruktsCountMin* sketch, const void* key, size_t key_len,
+                             uint32_t count)
+{
+    size_t indexes[STRUKTS_COUNT_MIN_MAX_DEPTH];
+
+    counter_indexes(sketch, key, key_len, indexes);
+    sketch->total += count;
+
+    const uint32_t estimate = min_counter(sketch, indexes);
+
+    /* conservative update: only counters below the key's new estimate are raised (to it) */
+    const uint32_t new_estimate = estimate > UINT32_MAX - count ? UINT32_MAX : estimate + count;
+
+    for (size_t i = 0; i < sketch->depth; i++) {
+        uint32_t* counter = &sketch->counters[indexes[i]];
+
+        /* branchless max: which of the counters are raised is unpredictable */
+        *counter = *counter < new_estimate ? new_estimate : *counter;
+    }
+}
+
+void strukts_count_min_add_many(StruktsCountMin* sketch, const char* const keys[], size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        strukts_count_min_add_n(sketch, keys[i], strlen(keys[i]), 1);
+}
+
+uint32_t strukts_count_min_estimate(const StruktsCountMin* sketch, const char* key)
+{
+    return strukts_count_min_estimate_n(sketch, key, strlen(key));
+}
+
+uint32_t strukts_count_min_estimate_n(const StruktsCountMin* sketch, const void* key,
+                                      size_t key_len)
+{
+    size_t indexes[STRUKTS_COUNT_MIN_MAX_DEPTH];
+
+    counter_indexes(sketch, key, key_len, indexes);
+
+    return min_counter(sketch, indexes);
+}
@@ -0,0 +1,357 @@
+#include "strukts_cuckoo_hashmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#define calloc sf_calloc
+#endif
+
+/********************** MACROS **********************/
+#define SLOTS STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS
+#define MAX_PATH_DEPTH 5     /* maximum amount of displacements of a single insertion */
+#define MAX_SEARCH_NODES 512 /* buckets visited by the breadth-first search */
+#define NO_SLOT SIZE_MAX
+
+/********************** PRIVATE STRUCTS **********************/
+typedef struct _StruktsCuckooHashmapSearchNode StruktsCuckooHashmapSearchNode;
+
+/* a bucket visited by the breadth-first search and how it's reached from its parent bucket */
+struct _StruktsCuckooHashmapSearchNode {
+    size_t bucket;
+    size_t parent;      /* index of the parent node in the search queue (roots have none) */
+    size_t parent_slot; /* slot of the parent whose key would be displaced into this bucket */
+    size_t depth;
+};
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline size_t bucket_index(const StruktsCuckooHashmap* hashmap, uint32_t hash)
+{
+    return hash & (hashmap->buckets_amount - 1);
+}
+
+static inline size_t alternate_bucket(const StruktsCuckooHashmap* hashmap,
+                                      const StruktsCuckooHashmapBucket* bucket, size_t slot,
+                                      size_t current)
+{
+    size_t first = bucket_index(hashmap, bucket->hashes[slot]);
+
+    return first != current ? first : bucket_index(hashmap, bucket->alt_hashes[slot]);
+}
+
+static inline size_t bucket_find_empty(const StruktsCuckooHashmapBucket* bucket)
+{
+    for (size_t slot = 0; slot < SLOTS; slot++) {
+        if (bucket->keys[slot] == NULL)
+            return slot;
+    }
+
+    return NO_SLOT;
+}
+
+static inline size_t bucket_find_key(const StruktsCuckooHashmapBucket* bucket, const char* key,
+                                     uint32_t hash, uint32_t alt_hash)
+{
+    for (size_t slot = 0; slot < SLOTS; slot++) {
+        if (bucket->keys[slot] != NULL && bucket->hashes[slot] == hash &&
+            bucket->alt_hashes[slot] == alt_hash && strcmp(bucket->keys[slot], key) == 0)
+            return slot;
+    }
+
+    return NO_SLOT;
+}
+
+static inline void slot_set(StruktsCuckooHashmap* hashmap, size_t bucket, size_t slot,
+                            const char* key, char* value, uint32_t hash, uint32_t alt_hash)
+{
+    hashmap->buckets[bucket].keys[slot] = key;
+    hashmap->buckets[bucket].hashes[slot] = hash;
+    hashmap->buckets[bucket].alt_hashes[slot] = alt_hash;
+    hashmap->values[bucket * SLOTS + slot] = value;
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static bool cuckoo_find(const StruktsCuckooHashmap* hashmap, const char* key, uint32_t hash,
+                        uint32_t alt_hash, size_t* found_bucket, size_t* found_slot)
+{
+    size_t candidates[2] = {bucket_index(hashmap, hash), bucket_index(hashmap, alt_hash)};
+
+    /* the only two buckets where the key can be */
+    for (size_t i = 0; i < 2; i++) {
+        size_t slot = bucket_find_key(&hashmap->buckets[candidates[i]], key, hash, alt_hash);
+
+        if (slot != NO_SLOT) {
+            *found_bucket = candidates[i];
+            *found_slot = slot;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Moves the key of a slot to an empty slot of its alternate bucket. Returns false when the move
+ * would break the invariants (a bucket repeated along the path has changed meanwhile).
+ */
+static bool cuckoo_move(StruktsCuckooHashmap* hashmap, size_t from_bucket, size_t from_slot,
+                        size_t to_bucket, size_t to_slot)
+{
+    StruktsCuckooHashmapBucket* from = &hashmap->buckets[from_bucket];
+
+    if (from->keys[from_slot] == NULL || hashmap->buckets[to_bucket].keys[to_slot] != NULL ||
+        alternate_bucket(hashmap, from, from_slot, from_bucket) != to_bucket)
+        return false;
+
+    slot_set(hashmap, to_bucket, to_slot, from->keys[from_slot],
+             hashmap->values[from_bucket * SLOTS + from_slot], from->hashes[from_slot],
+             from->alt_hashes[from_slot]);
+    from->keys[from_slot] = NULL;
+
+    return true;
+}
+
+/*
+ * Frees a slot in one of the key's two buckets: a breadth-first search over displacements finds
+ * the shortest cuckoo path to a bucket with an empty slot, which is then applied backwards (from
+ * the empty slot to the key's bucket) so that every single move keeps the hash map valid.
+ */
+static bool cuckoo_make_room(StruktsCuckooHashmap* hashmap, uint32_t hash, uint32_t alt_hash,
+                             size_t* free_bucket, size_t* free_slot)
+{
+    StruktsCuckooHashmapSearchNode queue[MAX_SEARCH_NODES];
+    size_t head = 0;
+    size_t tail = 0;
+
+    queue[tail++] = (StruktsCuckooHashmapSearchNode){bucket_index(hashmap, hash), NO_SLOT, 0, 0};
+    queue[tail++] =
+        (StruktsCuckooHashmapSearchNode){bucket_index(hashmap, alt_hash), NO_SLOT, 0, 0};
+
+    while (head < tail) {
+        size_t current = head++;
+        StruktsCuckooHashmapSearchNode node = queue[current];
+        StruktsCuckooHashmapBucket* bucket = &hashmap->buckets[node.bucket];
+        size_t empty_slot = bucket_find_empty(bucket);
+
+        if (empty_slot != NO_SLOT) {
+            /* applies the path backwards: each parent's key moves into the slot freed below it */
+            while (queue[current].parent != NO_SLOT) {
+                StruktsCuckooHashmapSearchNode child = queue[current];
+                StruktsCuckooHashmapSearchNode parent = queue[child.parent];
+
+                if (!cuckoo_move(hashmap, parent.bucket, child.parent_slot, child.bucket,
+                                 empty_slot))
+                    return false;
+
+                empty_slot = child.parent_slot;
+                current = child.parent;
+            }
+
+            *free_bucket = queue[current].bucket;
+            *free_slot = empty_slot;
+
+            return true;
+        }
+
+        if (node.depth == MAX_PATH_DEPTH)
+            continue;
+
+        for (size_t slot = 0; slot < SLOTS && tail < MAX_SEARCH_NODES; slot++) {
+            size_t next = alternate_bucket(hashmap, bucket, slot, node.bucket);
+
+            /* keys whose both hashes pick the same bucket can't be displaced */
+            if (next != node.bucket)
+                queue[tail++] =
+                    (StruktsCuckooHashmapSearchNode){next, current, slot, node.depth + 1};
+        }
+    }
+
+    return false;
+}
+
+static bool cuckoo_insert_new(StruktsCuckooHashmap* hashmap, const char* key, char* value,
+                              uint32_t hash, uint32_t alt_hash)
+{
+    size_t bucket;
+    size_t slot;
+
+    if (!cuckoo_make_room(hashmap, hash, alt_hash, &bucket, &slot))
+        return false;
+
+    slot_set(hashmap, bucket, slot, key, value, hash, alt_hash);
+    hashmap->size++;
+
+    return true;
+}
+
+static bool cuckoo_alloc_buckets(StruktsCuckooHashmap* hashmap, size_t buckets_amount)
+{
+    const size_t alignment = STRUKTS_CUCKOO_HASHMAP_CACHE_LINE;
+
+    /* over-allocates to align the buckets to cache lines: a bucket is read with a single line */
+    void* buckets_memory =
+        calloc(1, buckets_amount * sizeof(StruktsCuckooHashmapBucket) + alignment - 1);
+
+    if (buckets_memory == NULL)
+        return false;
+
+    char** values = (char**)malloc(buckets_amount * SLOTS * sizeof(char*));
+
+    if (values == NULL) {
+        free(buckets_memory);
+
+        return false;
+    }
+
+    uintptr_t address = ((uintptr_t)buckets_memory + alignment - 1) & ~(alignment - 1);
+
+    hashmap->buckets_memory = buckets_memory;
+    hashmap->buckets = (StruktsCuckooHashmapBucket*)address;
+    hashmap->buckets_amount = buckets_amount;
+    hashmap->values = values;
+    hashmap->size = 0;
+
+    return true;
+}
+
+static bool cuckoo_resize(StruktsCuckooHashmap* hashmap, size_t new_buckets_amount)
+{
+    StruktsCuckooHashmap old = *hashmap;
+
+    /* keeps doubling in the (unlikely) case that the keys don't fit in the new buckets either */
+    for (;; new_buckets_amount *= 2) {
+        if (!cuckoo_alloc_buckets(hashmap, new_buckets_amount)) {
+            *hashmap = old; /* on failure, the hashmap keeps its current buckets untouched */
+
+            return false;
+        }
+
+        bool reinserted = true;
+
+        /* both hashes are stored: keys are never hashed again */
+        for (size_t b = 0; b < old.buckets_amount && reinserted; b++) {
+            StruktsCuckooHashmapBucket* bucket = &old.buckets[b];
+
+            for (size_t slot = 0; slot < SLOTS && reinserted; slot++) {
+                if (bucket->keys[slot] != NULL)
+                    reinserted = cuckoo_insert_new(hashmap, bucket->keys[slot],
+                                                   old.values[b * SLOTS + slot],
+                                                   bucket->hashes[slot], bucket->alt_hashes[slot]);
+            }
+        }
+
+        if (reinserted)
+            break;
+
+        free(hashmap->buckets_memory);
+        free(hashmap->values);
+    }
+
+    free(old.buckets_memory);
+    free(old.values);
+
+    return true;
+}
+
+static bool is_resizing_needed(const StruktsCuckooHashmap* hashmap)
+{
+    /* load factor after the new key is added */
+    return (double)(hashmap->size + 1) / (double)(hashmap->buckets_amount * SLOTS) >
+           STRUKTS_CUCKOO_HASHMAP_MAX_LOAD_FACTOR;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsCuckooHashmap* strukts_cuckoo_hashmap_new()
+{
+    StruktsCuckooHashmap* hashmap = (StruktsCuckooHashmap*)malloc(sizeof(StruktsCuckooHashmap));
+
+    if (hashmap == NULL)
+        return NULL;
+
+    if (!cuckoo_alloc_buckets(hashmap, STRUKTS_CUCKOO_HASHMAP_INITIAL_BUCKETS)) {
+        free(hashmap);
+
+        return NULL;
+    }
+
+    return hashmap;
+}
+
+void strukts_cuckoo_hashmap_free(StruktsCuckooHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    free(hashmap->buckets_memory);
+    free(hashmap->values);
+    free(hashmap);
+}
+
+bool strukts_cuckoo_hashmap_upsert(StruktsCuckooHashmap* hashmap, const char* key, char* value)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_SEED);
+    uint32_t alt_hash =
+        strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_ALT_SEED);
+    size_t bucket;
+    size_t slot;
+
+    /* existing keys just have their values replaced */
+    if (cuckoo_find(hashmap, key, hash, alt_hash, &bucket, &slot)) {
+        hashmap->values[bucket * SLOTS + slot] = value;
+
+        return true;
+    }
+
+    if (is_resizing_needed(hashmap) && !cuckoo_resize(hashmap, 2 * hashmap->buckets_amount))
+        return false;
+
+    /* no cuckoo path was found: grows until one is */
+    while (!cuckoo_insert_new(hashmap, key, value, hash, alt_hash)) {
+        if (!cuckoo_resize(hashmap, 2 * hashmap->buckets_amount))
+            return false;
+    }
+
+    return true;
+}
+
+bool strukts_cuckoo_hashmap_remove(StruktsCuckooHashmap* hashmap, const char* key)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_SEED);
+    uint32_t alt_hash =
+        strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_ALT_SEED);
+    size_t bucket;
+    size_t slot;
+
+    if (!cuckoo_find(hashmap, key, hash, alt_hash, &bucket, &slot))
+        return false;
+
+    hashmap->buckets[bucket].keys[slot] = NULL;
+    hashmap->size--;
+
+    return true;
+}
+
+char* strukts_cuckoo_hashmap_get(const StruktsCuckooHashmap* hashmap, const char* key)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_SEED);
+    uint32_t alt_hash =
+        strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_ALT_SEED);
+    size_t bucket;
+    size_t slot;
+
+    if (!cuckoo_find(hashmap, key, hash, alt_hash, &bucket, &slot))
+        return NULL;
+
+    return hashmap->values[bucket * SLOTS + slot];
+}
@@ -0,0 +1,168 @@
+#include "strukts_epoch.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define READER_ACTIVE 1u /* lowest bit of a reader's state */
+
+/********************** PRIVATE FUNCTIONS **********************/
+static void limbo_free(StruktsEpochDomain* domain, size_t limbo_index)
+{
+    StruktsEpochRetired* retired = domain->limbo[limbo_index];
+
+    while (retired != NULL) {
+        StruktsEpochRetired* next_retired = retired->next;
+
+        retired->free_object(retired->object);
+        free(retired);
+        domain->retired_amount--;
+
+        retired = next_retired;
+    }
+
+    domain->limbo[limbo_index] = NULL;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsEpochDomain* strukts_epoch_domain_new(size_t readers_capacity)
+{
+    const size_t alignment = STRUKTS_EPOCH_CACHE_LINE;
+
+    if (readers_capacity == 0)
+        return NULL; /* impossible allocation */
+
+    StruktsEpochDomain* domain = (StruktsEpochDomain*)malloc(sizeof(StruktsEpochDomain));
+
+    if (domain == NULL)
+        return NULL;
+
+    /* over-allocates to align the reader slots to cache lines */
+    domain->readers_memory = malloc(readers_capacity * sizeof(StruktsEpochReader) + alignment - 1);
+
+    if (domain->readers_memory == NULL) {
+        free(domain);
+
+        return NULL;
+    }
+
+    uintptr_t address = ((uintptr_t)domain->readers_memory + alignment - 1) & ~(alignment - 1);
+    domain->readers = (StruktsEpochReader*)address;
+    domain->readers_capacity = readers_capacity;
+    domain->global_epoch = 0;
+    domain->retired_amount = 0;
+
+    memset(domain->readers, 0, readers_capacity * sizeof(StruktsEpochReader));
+
+    for (size_t i = 0; i < STRUKTS_EPOCH_LIMBO_LISTS; i++)
+        domain->limbo[i] = NULL;
+
+    return domain;
+}
+
+void strukts_epoch_domain_free(StruktsEpochDomain* domain)
+{
+    if (domain == NULL)
+        return;
+
+    /* no readers are left: every retired object can be deallocated */
+    for (size_t i = 0; i < STRUKTS_EPOCH_LIMBO_LISTS; i++)
+        limbo_free(domain, i);
+
+    free(domain->readers_memory);
+    free(domain);
+}
+
+StruktsEpochReader* strukts_epoch_reader_register(StruktsEpochDomain* domain)
+{
+    for (size_t i = 0; i < domain->readers_capacity; i++) {
+        StruktsEpochReader* reader = &domain->readers[i];
+
+        if (!reader->registered) {
+            reader->registered = true;
+            __atomic_store_n(&reader->state, 0, __ATOMIC_RELEASE);
+
+            return reader;
+        }
+    }
+
+    return NULL;
+}
+
+void strukts_epoch_reader_unregister(StruktsEpochDomain* domain, StruktsEpochReader* reader)
+{
+    (void)domain;
+
+    __atomic_store_n(&reader->state, 0, __ATOMIC_RELEASE);
+    reader->registered = false;
+}
+
+void strukts_epoch_enter(StruktsEpochDomain* domain, StruktsEpochReader* reader)
+{
+    uint64_t epoch = __atomic_load_n(&domain->global_epoch, __ATOMIC_RELAXED);
+
+    /*
+     * Plain store + full fence (no read-modify-write): either a writer trying to advance the epoch
+     * sees this reader's state, or this reader sees every unlink that writer did before.
+     */
+    __atomic_store_n(&reader->state, (epoch << 1) | READER_ACTIVE, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+void strukts_epoch_exit(StruktsEpochReader* reader)
+{
+    __atomic_store_n(&reader->state, 0, __ATOMIC_RELEASE);
+}
+
+bool strukts_epoch_retire(StruktsEpochDomain* domain, void* object, void (*free_object)(void*))
+{
+    StruktsEpochRetired* retired = (StruktsEpochRetired*)malloc(sizeof(StruktsEpochRetired));
+
+    if (retired == NULL)
+        return false;
+
+    size_t limbo_index = __atomic_load_n(&domain->global_epoch, __ATOMIC_RELAXED) %
+                         STRUKTS_EPOCH_LIMBO_LISTS;
+
+    retired->object = object;
+    retired->free_object = free_object;
+    retired->next = domain->limbo[limbo_index];
+    domain->limbo[limbo_index] = retired;
+    domain->retired_amount++;
+
+    return true;
+}
+
+bool strukts_epoch_try_reclaim(StruktsEpochDomain* domain)
+{
+    uint64_t epoch = __atomic_load_n(&domain->global_epoch, __ATOMIC_RELAXED);
+
+    /* orders the writer's unlinks before reading the readers' states (pairs with enter's fence) */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    for (size_t i = 0; i < domain->readers_capacity; i++) {
+        uint64_t state = __atomic_load_n(&domain->readers[i].state, __ATOMIC_ACQUIRE);
+
+        /* an active reader that hasn't observed the current epoch yet blocks the advance */
+        if ((state & READER_ACTIVE) && (state >> 1) != epoch)
+            return false;
+    }
+
+    __atomic_store_n(&domain->global_epoch, epoch + 1, __ATOMIC_RELEASE);
+
+    /*
+     * Active readers are all in the epoch that has just ended, so objects retired two epochs ago
+     * (epoch - 1, whose limbo list is reused by epoch + 2) are unreachable now.
+     */
+    limbo_free(domain, (epoch + 2) % STRUKTS_EPOCH_LIMBO_LISTS);
+
+    return true;
+}
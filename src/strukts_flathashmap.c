@@ -0,0 +1,251 @@
+#include "strukts_flathashmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define CONTROL_EMPTY 0x80 /* empty slots have the high bit set, full slots hold a 7-bit tag */
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint32_t hash_key(const char* key)
+{
+    return strukts_murmur3_hash((const uint8_t*)key, strlen(key), 0);
+}
+
+static inline uint8_t hash_tag(uint32_t hash)
+{
+    /* the 7 highest bits of the hash are the tag whereas the lowest ones select the group */
+    return (uint8_t)(hash >> 25);
+}
+
+static inline uint32_t group_match_tag(const uint8_t* controls, uint8_t tag)
+{
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i*)controls);
+    __m128i matches = _mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag));
+
+    return (uint32_t)_mm_movemask_epi8(matches);
+#else
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < STRUKTS_FLATHASHMAP_GROUP_WIDTH; i++) {
+        if (controls[i] == tag)
+            mask |= 1u << i;
+    }
+
+    return mask;
+#endif
+}
+
+static inline uint32_t group_match_empty(const uint8_t* controls)
+{
+#ifdef __SSE2__
+    /* only empty control bytes have their high bit set, which is exactly what movemask gathers */
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)controls));
+#else
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < STRUKTS_FLATHASHMAP_GROUP_WIDTH; i++) {
+        if (controls[i] & CONTROL_EMPTY)
+            mask |= 1u << i;
+    }
+
+    return mask;
+#endif
+}
+
+static inline size_t lowest_bit_index(uint32_t mask)
+{
+    return (size_t)__builtin_ctz(mask);
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static StruktsFlatHashmapSlot* flathashmap_find(const StruktsFlatHashmap* hashmap,
+                                                const char* key, uint32_t hash)
+{
+    const size_t group_mask = hashmap->capacity / STRUKTS_FLATHASHMAP_GROUP_WIDTH - 1;
+    const uint8_t tag = hash_tag(hash);
+    size_t group = hash & group_mask;
+
+    /*
+     * Triangular probing over groups (group + 1, + 2, + 3, ...) visits every group when the amount
+     * of groups is a power of 2. As the load factor is always below 1, there's always an empty slot
+     * that ends the probe sequence of a missing key.
+     */
+    for (size_t probe = 1;; probe++) {
+        const size_t first_slot = group * STRUKTS_FLATHASHMAP_GROUP_WIDTH;
+        const uint8_t* controls = hashmap->controls + first_slot;
+        uint32_t matches = group_match_tag(controls, tag);
+
+        /* only slots with the same tag have their keys compared */
+        while (matches != 0) {
+            StruktsFlatHashmapSlot* slot = &hashmap->slots[first_slot + lowest_bit_index(matches)];
+
+            if (strcmp(slot->key, key) == 0)
+                return slot;
+
+            matches &= matches - 1; /* clears the lowest set bit */
+        }
+
+        if (group_match_empty(controls) != 0)
+            return NULL;
+
+        group = (group + probe) & group_mask;
+    }
+}
+
+static void flathashmap_insert_new(StruktsFlatHashmap* hashmap, const char* key, char* value,
+                                   uint32_t hash)
+{
+    const size_t group_mask = hashmap->capacity / STRUKTS_FLATHASHMAP_GROUP_WIDTH - 1;
+    size_t group = hash & group_mask;
+
+    /* same probe sequence used by flathashmap_find: stops at the first group with an empty slot */
+    for (size_t probe = 1;; probe++) {
+        const size_t first_slot = group * STRUKTS_FLATHASHMAP_GROUP_WIDTH;
+        uint32_t empties = group_match_empty(hashmap->controls + first_slot);
+
+        if (empties != 0) {
+            size_t i = first_slot + lowest_bit_index(empties);
+
+            hashmap->controls[i] = hash_tag(hash);
+            hashmap->slots[i].key = key;
+            hashmap->slots[i].value = value;
+            hashmap->size++;
+
+            return;
+        }
+
+        group = (group + probe) & group_mask;
+    }
+}
+
+static bool flathashmap_alloc_slots(StruktsFlatHashmap* hashmap, size_t capacity)
+{
+    uint8_t* controls = (uint8_t*)malloc(capacity * sizeof(uint8_t));
+
+    if (controls == NULL)
+        return false;
+
+    StruktsFlatHashmapSlot* slots =
+        (StruktsFlatHashmapSlot*)malloc(capacity * sizeof(StruktsFlatHashmapSlot));
+
+    if (slots == NULL) {
+        free(controls);
+
+        return false;
+    }
+
+    /* all slots start empty: slots contents are only read when their control byte is full */
+    memset(controls, CONTROL_EMPTY, capacity * sizeof(uint8_t));
+
+    hashmap->capacity = capacity;
+    hashmap->size = 0;
+    hashmap->controls = controls;
+    hashmap->slots = slots;
+
+    return true;
+}
+
+static bool flathashmap_resize(StruktsFlatHashmap* hashmap, size_t new_capacity)
+{
+    const size_t old_capacity = hashmap->capacity;
+    uint8_t* old_controls = hashmap->controls;
+    StruktsFlatHashmapSlot* old_slots = hashmap->slots;
+
+    /* on failure, the hashmap keeps its current slots untouched */
+    if (!flathashmap_alloc_slots(hashmap, new_capacity))
+        return false;
+
+    /* reinserts every full slot: keys are known to be unique so no lookups are needed */
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_controls[i] & CONTROL_EMPTY)
+            continue;
+
+        StruktsFlatHashmapSlot* slot = &old_slots[i];
+        flathashmap_insert_new(hashmap, slot->key, slot->value, hash_key(slot->key));
+    }
+
+    free(old_controls);
+    free(old_slots);
+
+    return true;
+}
+
+static bool is_resizing_needed(const StruktsFlatHashmap* hashmap)
+{
+    /* load factor after the new key is added */
+    return (float)(hashmap->size + 1) / (float)hashmap->capacity >
+           STRUKTS_FLATHASHMAP_MAX_LOAD_FACTOR;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsFlatHashmap* strukts_flathashmap_new()
+{
+    StruktsFlatHashmap* hashmap = (StruktsFlatHashmap*)malloc(sizeof(StruktsFlatHashmap));
+
+    if (hashmap == NULL)
+        return NULL;
+
+    if (!flathashmap_alloc_slots(hashmap, STRUKTS_FLATHASHMAP_INITIAL_CAPACITY)) {
+        free(hashmap);
+
+        return NULL;
+    }
+
+    return hashmap;
+}
+
+void strukts_flathashmap_free(StruktsFlatHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    free(hashmap->controls);
+    free(hashmap->slots);
+    free(hashmap);
+}
+
+bool strukts_flathashmap_add(StruktsFlatHashmap* hashmap, const char* key, char* value)
+{
+    uint32_t hash = hash_key(key);
+    StruktsFlatHashmapSlot* slot = flathashmap_find(hashmap, key, hash);
+
+    /* existing keys just have their values replaced */
+    if (slot != NULL) {
+        slot->value = value;
+
+        return true;
+    }
+
+    if (is_resizing_needed(hashmap) && !flathashmap_resize(hashmap, 2 * hashmap->capacity))
+        return false;
+
+    flathashmap_insert_new(hashmap, key, value, hash);
+
+    return true;
+}
+
+char* strukts_flathashmap_get(const StruktsFlatHashmap* hashmap, const char* key)
+{
+    StruktsFlatHashmapSlot* slot = flathashmap_find(hashmap, key, hash_key(key));
+
+    if (slot == NULL)
+        return NULL;
+
+    return slot->value;
+}
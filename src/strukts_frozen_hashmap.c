@@ -0,0 +1,79 @@
+#include "strukts_frozen_hashmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_perfect_hash.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsFrozenHashmap* strukts_frozen_hashmap_new(const char* const keys[], char* const values[],
+                                                 size_t n)
+{
+    StruktsFrozenHashmap* hashmap = (StruktsFrozenHashmap*)malloc(sizeof(StruktsFrozenHashmap));
+
+    if (hashmap == NULL)
+        return NULL;
+
+    hashmap->size = n;
+    hashmap->perfect_hash = strukts_perfect_hash_build(keys, n);
+    hashmap->entries =
+        (StruktsFrozenHashmapEntry*)malloc((n > 0 ? n : 1) * sizeof(StruktsFrozenHashmapEntry));
+
+    if (hashmap->perfect_hash == NULL || hashmap->entries == NULL) {
+        strukts_frozen_hashmap_free(hashmap);
+
+        return NULL;
+    }
+
+    /* every key owns exactly one entry of the dense array */
+    for (size_t i = 0; i < n; i++) {
+        StruktsFrozenHashmapEntry* entry =
+            &hashmap->entries[strukts_perfect_hash_index(hashmap->perfect_hash, keys[i])];
+
+        entry->key = keys[i];
+        entry->key_len = strlen(keys[i]);
+        entry->value = values[i];
+    }
+
+    return hashmap;
+}
+
+void strukts_frozen_hashmap_free(StruktsFrozenHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    strukts_perfect_hash_free(hashmap->perfect_hash);
+    free(hashmap->entries);
+    free(hashmap);
+}
+
+char* strukts_frozen_hashmap_get(const StruktsFrozenHashmap* hashmap, const char* key)
+{
+    return strukts_frozen_hashmap_get_n(hashmap, key, strlen(key));
+}
+
+char* strukts_frozen_hashmap_get_n(const StruktsFrozenHashmap* hashmap, const void* key,
+                                   size_t key_len)
+{
+    const size_t index = strukts_perfect_hash_index_n(hashmap->perfect_hash, key, key_len);
+
+    if (index == STRUKTS_PERFECT_HASH_NOT_FOUND)
+        return NULL;
+
+    /* keys that are not in the set may be mapped to any entry: the entry's key must match */
+    const StruktsFrozenHashmapEntry* entry = &hashmap->entries[index];
+
+    if (entry->key_len != key_len || memcmp(entry->key, key, key_len) != 0)
+        return NULL;
+
+    return entry->value;
+}
@@ -5,6 +5,24 @@
 #include <string.h>
 #include <strukts_types.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define X86_SIMD /* AVX2/AVX-512 kernels are compiled (and picked at runtime) */
+#endif
+
+/********************** MACROS **********************/
+/* constants of the 32-bit variant: shared by the scalar and the SIMD implementations */
+#define MURMUR3_C1 0xcc9e2d51u
+#define MURMUR3_C2 0x1b873593u
+#define MURMUR3_R1 15
+#define MURMUR3_R2 13
+#define MURMUR3_M 5
+#define MURMUR3_N 0xe6546b64u
+#define MURMUR3_FMIX1 0x85ebca6bu
+#define MURMUR3_FMIX2 0xc2b2ae35u
+
+#define SIMD_LEVEL_UNKNOWN 0xffffffffu
+
 /********************** STATIC INLINE FUNCTIONS **********************/
 static inline WORD rotate_left(WORD value, BYTE amount)
 {
@@ -13,23 +31,16 @@ static inline WORD rotate_left(WORD value, BYTE amount)
 
 static inline WORD mur(WORD hash, WORD block, bool final_rotate)
 {
-    const WORD c1 = 0xcc9e2d51;
-    const WORD c2 = 0x1b873593;
-    const BYTE r1 = 15;
-    const BYTE r2 = 13;
-    const BYTE m = 5;
-    const WORD n = 0xe6546b64;
-
-    block *= c1;
-    block = rotate_left(block, r1);
-    block *= c2;
+    block *= MURMUR3_C1;
+    block = rotate_left(block, MURMUR3_R1);
+    block *= MURMUR3_C2;
     hash ^= block;
 
     if (!final_rotate)
         return hash;
 
-    hash = rotate_left(hash, r2);
-    hash = (hash * m) + n;
+    hash = rotate_left(hash, MURMUR3_R2);
+    hash = (hash * MURMUR3_M) + MURMUR3_N;
 
     return hash;
 }
@@ -42,9 +53,9 @@ static inline WORD final_avalanche(WORD hash, size_t key_len)
      */
     hash ^= key_len;
     hash ^= (hash >> 16);
-    hash *= 0x85ebca6b;
+    hash *= MURMUR3_FMIX1;
     hash ^= hash >> 13;
-    hash *= 0xc2b2ae35;
+    hash *= MURMUR3_FMIX2;
     hash ^= hash >> 16;
 
     return hash;
@@ -68,6 +79,174 @@ static inline WORD build_final_block(const BYTE* key, BYTE remaining_bytes)
     return final_block;
 }
 
+static inline uint64_t rotate_left_64(uint64_t value, BYTE amount)
+{
+    return value << amount | value >> (64 - amount);
+}
+
+static inline uint64_t mix_k1(uint64_t k1)
+{
+    k1 *= 0x87c37b91114253d5ull;
+    k1 = rotate_left_64(k1, 31);
+
+    return k1 * 0x4cf5ad432745937full;
+}
+
+static inline uint64_t mix_k2(uint64_t k2)
+{
+    k2 *= 0x4cf5ad432745937full;
+    k2 = rotate_left_64(k2, 33);
+
+    return k2 * 0x87c37b91114253d5ull;
+}
+
+static inline uint64_t final_avalanche_64(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+static inline WORD load_block(const BYTE* key)
+{
+    WORD block;
+
+    memcpy(&block, key, sizeof(WORD));
+
+    return block;
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+#ifdef X86_SIMD
+__attribute__((target("avx2"))) static inline __m256i rotate_left_avx2(__m256i value, int amount)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(value, amount), _mm256_srli_epi32(value, 32 - amount));
+}
+
+__attribute__((target("avx2"))) static inline __m256i mur_avx2(__m256i hash, __m256i block,
+                                                               bool final_rotate)
+{
+    block = _mm256_mullo_epi32(block, _mm256_set1_epi32((int)MURMUR3_C1));
+    block = rotate_left_avx2(block, MURMUR3_R1);
+    block = _mm256_mullo_epi32(block, _mm256_set1_epi32((int)MURMUR3_C2));
+    hash = _mm256_xor_si256(hash, block);
+
+    if (!final_rotate)
+        return hash;
+
+    hash = rotate_left_avx2(hash, MURMUR3_R2);
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(MURMUR3_M));
+
+    return _mm256_add_epi32(hash, _mm256_set1_epi32((int)MURMUR3_N));
+}
+
+/* one lane per key: lane i runs the rounds of keys[i] */
+__attribute__((target("avx2"))) static void hash_8_avx2(const BYTE* const keys[], size_t key_len,
+                                                        WORD seed, WORD hashes[])
+{
+    __m256i hash = _mm256_set1_epi32((int)seed);
+    size_t offset = 0;
+    WORD blocks[8];
+
+    /* the keys' blocks are transposed into lanes: lane i gets the next block of keys[i] */
+    for (; offset + sizeof(WORD) <= key_len; offset += sizeof(WORD)) {
+        const __m256i block = _mm256_setr_epi32(
+            (int)load_block(keys[0] + offset), (int)load_block(keys[1] + offset),
+            (int)load_block(keys[2] + offset), (int)load_block(keys[3] + offset),
+            (int)load_block(keys[4] + offset), (int)load_block(keys[5] + offset),
+            (int)load_block(keys[6] + offset), (int)load_block(keys[7] + offset));
+
+        hash = mur_avx2(hash, block, true);
+    }
+
+    /* a zero final block leaves the hash untouched: it's only mixed for partial blocks */
+    if (key_len & 3) {
+        for (size_t i = 0; i < 8; i++)
+            blocks[i] = build_final_block(keys[i] + offset, key_len & 3);
+
+        hash = mur_avx2(hash, _mm256_loadu_si256((const __m256i*)blocks), false);
+    }
+
+    hash = _mm256_xor_si256(hash, _mm256_set1_epi32((int)(WORD)key_len));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)MURMUR3_FMIX1));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32((int)MURMUR3_FMIX2));
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+
+    _mm256_storeu_si256((__m256i*)hashes, hash);
+}
+
+__attribute__((target("avx512f"))) static inline __m512i mur_avx512(__m512i hash, __m512i block,
+                                                                    bool final_rotate)
+{
+    block = _mm512_mullo_epi32(block, _mm512_set1_epi32((int)MURMUR3_C1));
+    block = _mm512_rol_epi32(block, MURMUR3_R1);
+    block = _mm512_mullo_epi32(block, _mm512_set1_epi32((int)MURMUR3_C2));
+    hash = _mm512_xor_si512(hash, block);
+
+    if (!final_rotate)
+        return hash;
+
+    hash = _mm512_rol_epi32(hash, MURMUR3_R2);
+    hash = _mm512_mullo_epi32(hash, _mm512_set1_epi32(MURMUR3_M));
+
+    return _mm512_add_epi32(hash, _mm512_set1_epi32((int)MURMUR3_N));
+}
+
+/* AVX-512 rotates natively (vprold): lane i runs the rounds of keys[i] */
+__attribute__((target("avx512f"))) static void hash_16_avx512(const BYTE* const keys[],
+                                                              size_t key_len, WORD seed,
+                                                              WORD hashes[])
+{
+    __m512i hash = _mm512_set1_epi32((int)seed);
+    size_t offset = 0;
+    WORD blocks[16];
+
+    for (; offset + sizeof(WORD) <= key_len; offset += sizeof(WORD)) {
+        for (size_t i = 0; i < 16; i++)
+            blocks[i] = load_block(keys[i] + offset);
+
+        hash = mur_avx512(hash, _mm512_loadu_si512(blocks), true);
+    }
+
+    if (key_len & 3) {
+        for (size_t i = 0; i < 16; i++)
+            blocks[i] = build_final_block(keys[i] + offset, key_len & 3);
+
+        hash = mur_avx512(hash, _mm512_loadu_si512(blocks), false);
+    }
+
+    hash = _mm512_xor_si512(hash, _mm512_set1_epi32((int)(WORD)key_len));
+    hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 16));
+    hash = _mm512_mullo_epi32(hash, _mm512_set1_epi32((int)MURMUR3_FMIX1));
+    hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 13));
+    hash = _mm512_mullo_epi32(hash, _mm512_set1_epi32((int)MURMUR3_FMIX2));
+    hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 16));
+
+    _mm512_storeu_si512(hashes, hash);
+}
+#endif
+
+static unsigned int detect_simd_level()
+{
+#ifdef X86_SIMD
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return STRUKTS_MURMUR3_AVX512;
+
+    if (__builtin_cpu_supports("avx2"))
+        return STRUKTS_MURMUR3_AVX2;
+#endif
+
+    return STRUKTS_MURMUR3_SCALAR;
+}
+
 /********************** PUBLIC FUNCTIONS **********************/
 WORD strukts_murmur3_hash(const BYTE* key, size_t key_len, WORD seed)
 {
@@ -86,4 +265,161 @@ WORD strukts_murmur3_hash(const BYTE* key, size_t key_len, WORD seed)
     hash = mur(hash, block, false);
 
     return final_avalanche(hash, key_len);
-}
\ No newline at end of file
+}
+
+void strukts_murmur3_hash_x64_128(const BYTE* key, size_t key_len, WORD seed, uint64_t out[2])
+{
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    /* iterative block hashing of the whole key in 16-bytes blocks: two 64-bit lanes per block */
+    for (size_t i = 0; i < key_len / 16; ++i) {
+        memcpy(&k1, key, sizeof(uint64_t));
+        memcpy(&k2, key + sizeof(uint64_t), sizeof(uint64_t));
+
+        h1 ^= mix_k1(k1);
+        h1 = rotate_left_64(h1, 27) + h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        h2 ^= mix_k2(k2);
+        h2 = rotate_left_64(h2, 31) + h1;
+        h2 = h2 * 5 + 0x38495ab5;
+
+        key += 2 * sizeof(uint64_t);
+    }
+
+    /* remaining 0-15 bytes: the first 8 go to the k1 lane and the rest to the k2 lane */
+    const size_t remaining_bytes = key_len & 15;
+
+    k1 = 0;
+    k2 = 0;
+
+    if (remaining_bytes > 8) {
+        memcpy(&k2, key + sizeof(uint64_t), remaining_bytes - 8);
+        h2 ^= mix_k2(k2);
+    }
+
+    if (remaining_bytes > 0) {
+        memcpy(&k1, key, remaining_bytes > 8 ? 8 : remaining_bytes);
+        h1 ^= mix_k1(k1);
+    }
+
+    h1 ^= key_len;
+    h2 ^= key_len;
+    h1 += h2;
+    h2 += h1;
+    h1 = final_avalanche_64(h1);
+    h2 = final_avalanche_64(h2);
+    h1 += h2;
+    h2 += h1;
+
+    out[0] = h1;
+    out[1] = h2;
+}
+
+void strukts_murmur3_init(StruktsMurmur3Context* context, WORD seed)
+{
+    context->hash = seed;
+    context->tail_len = 0;
+    context->key_len = 0;
+}
+
+void strukts_murmur3_update(StruktsMurmur3Context* context, const BYTE* fragment,
+                            size_t fragment_len)
+{
+    WORD block = 0;
+
+    context->key_len += fragment_len;
+
+    /* completes the partial block carried over from the previous fragments */
+    if (context->tail_len > 0) {
+        while (context->tail_len < 4 && fragment_len > 0) {
+            context->tail[context->tail_len++] = *fragment++;
+            fragment_len--;
+        }
+
+        if (context->tail_len < 4)
+            return;
+
+        memcpy(&block, context->tail, sizeof(WORD));
+        context->hash = mur(context->hash, block, true);
+        context->tail_len = 0;
+    }
+
+    /* whole blocks are hashed straight from the fragment, just like strukts_murmur3_hash */
+    for (size_t i = 0; i < fragment_len / 4; ++i) {
+        memcpy(&block, fragment, sizeof(WORD));
+        context->hash = mur(context->hash, block, true);
+
+        fragment += sizeof(WORD);
+    }
+
+    context->tail_len = fragment_len & 3;
+    memcpy(context->tail, fragment, context->tail_len);
+}
+
+WORD strukts_murmur3_final(const StruktsMurmur3Context* context)
+{
+    const WORD block = build_final_block(context->tail, (BYTE)context->tail_len);
+    const WORD hash = mur(context->hash, block, false);
+
+    return final_avalanche(hash, context->key_len);
+}
+
+WORD strukts_murmur3_hash_iov(const struct iovec* fragments, size_t fragments_amount, WORD seed)
+{
+    StruktsMurmur3Context context;
+
+    strukts_murmur3_init(&context, seed);
+
+    for (size_t i = 0; i < fragments_amount; i++)
+        strukts_murmur3_update(&context, (const BYTE*)fragments[i].iov_base, fragments[i].iov_len);
+
+    return strukts_murmur3_final(&context);
+}
+
+unsigned int strukts_murmur3_simd_level()
+{
+    static unsigned int simd_level = SIMD_LEVEL_UNKNOWN;
+    unsigned int level = __atomic_load_n(&simd_level, __ATOMIC_RELAXED);
+
+    /* racing threads detect the same level: any of them can store it */
+    if (level == SIMD_LEVEL_UNKNOWN) {
+        level = detect_simd_level();
+        __atomic_store_n(&simd_level, level, __ATOMIC_RELAXED);
+    }
+
+    return level;
+}
+
+void strukts_murmur3_hash_many(const BYTE* const keys[], size_t key_len, size_t n, WORD seed,
+                               WORD hashes[])
+{
+    strukts_murmur3_hash_many_with_level(keys, key_len, n, seed, hashes, STRUKTS_MURMUR3_AVX512);
+}
+
+void strukts_murmur3_hash_many_with_level(const BYTE* const keys[], size_t key_len, size_t n,
+                                          WORD seed, WORD hashes[], unsigned int simd_level)
+{
+    const unsigned int supported_level = strukts_murmur3_simd_level();
+    size_t i = 0;
+
+    if (simd_level > supported_level)
+        simd_level = supported_level;
+
+#ifdef X86_SIMD
+    if (simd_level >= STRUKTS_MURMUR3_AVX512)
+        for (; i + 16 <= n; i += 16)
+            hash_16_avx512(keys + i, key_len, seed, hashes + i);
+
+    if (simd_level >= STRUKTS_MURMUR3_AVX2)
+        for (; i + 8 <= n; i += 8)
+            hash_8_avx2(keys + i, key_len, seed, hashes + i);
+#endif
+
+    /* scalar fallback: the keys that don't fill a whole vector (or all keys without SIMD) */
+    for (; i < n; i++)
+        hashes[i] = strukts_murmur3_hash(keys[i], key_len, seed);
+}
@@ -1,25 +1,208 @@
 #include "strukts_hashmap.h"
 
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
+#include "strukts_arena.h"
+#include "strukts_bloom_filter.h"
 #include "strukts_hashing.h"
-#include "strukts_linkedlist.h"
 
 #ifdef DEBUG
 #include "sfmalloc.h"
 #define malloc sf_malloc
+#define calloc sf_calloc
 #define free sf_free
 #endif
 
+/********************** MACROS **********************/
+#define PREFETCH(address) __builtin_prefetch(address)
+
+/********************** PRIVATE STRUCTS **********************/
+typedef struct _StruktsHashmapBuildTask StruktsHashmapBuildTask;
+
+/* slice of a bulk build done by one thread: keys [from, to) to hash or the keys key_order[from, to)
+ * to link into its own buckets (buckets are owned by a single task, so no chain is ever written by
+ * two threads) */
+struct _StruktsHashmapBuildTask {
+    StruktsHashmap* hashmap;
+    const char* const* keys;
+    char* const* values;
+    size_t* key_lens;
+    uint32_t* key_hashes;
+    size_t* key_order;
+    size_t from;
+    size_t to;
+    bool failed;
+};
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline bool is_rehashing(const StruktsHashmap* hashmap)
+{
+    return hashmap->old_buckets != NULL;
+}
+
+static inline uint32_t hash_key(const StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                uint32_t* upper_hash)
+{
+    const uint8_t* key_bytes = (const uint8_t*)key;
+    const uint32_t seed = 0;
+
+    /* the upper 64 bits of the 128-bit hash come for free: they're Bloom filters' second hash */
+    if (hashmap->flags & STRUKTS_HASHMAP_MURMUR3_128) {
+        uint64_t hash[2];
+
+        strukts_murmur3_hash_x64_128(key_bytes, key_len, seed, hash);
+        *upper_hash = (uint32_t)hash[1];
+
+        return (uint32_t)hash[0];
+    }
+
+    *upper_hash = 0;
+
+    return strukts_murmur3_hash(key_bytes, key_len, seed);
+}
+
+static inline uint32_t alt_hash_key(const StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                    uint32_t upper_hash)
+{
+    /* 32-bit hashes need a second pass over the key with another seed */
+    if (hashmap->flags & STRUKTS_HASHMAP_MURMUR3_128)
+        return upper_hash;
+
+    return strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_BLOOM_FILTER_ALT_SEED);
+}
+
+static inline bool is_rejected_by_filter(const StruktsHashmap* hashmap, const void* key,
+                                         size_t key_len, uint32_t hash, uint32_t upper_hash)
+{
+    const StruktsBloomFilter* filter = hashmap->bloom_filter;
+
+    if (filter == NULL)
+        return false;
+
+    /* the key's hash already is the filter's first hash (same murmur3 seed): the bits it picks on
+     * its own reject keys before any second hash is computed */
+    if (!strukts_bloom_filter_might_contain_first_hash(filter, hash))
+        return true;
+
+    return !strukts_bloom_filter_might_contain_hashes(
+        filter, hash, alt_hash_key(hashmap, key, key_len, upper_hash));
+}
+
+static inline bool entry_has_key(const StruktsHashmapEntry* entry, const void* key, size_t key_len,
+                                 uint32_t hash)
+{
+    /* key bytes are only compared when both the hash and the key length match */
+    return entry->hash == hash && entry->key_len == key_len &&
+           memcmp(entry->key, key, key_len) == 0;
+}
+
+static inline size_t entry_size(unsigned int flags)
+{
+    /* owned keys reserve room for short keys right after their entries */
+    if (flags & STRUKTS_HASHMAP_OWN_KEYS)
+        return sizeof(StruktsHashmapEntry) + STRUKTS_HASHMAP_INLINE_KEY_SIZE;
+
+    return sizeof(StruktsHashmapEntry);
+}
+
+static inline StruktsHashmapEntry* entry_new(StruktsHashmap* hashmap)
+{
+    if (hashmap->arena != NULL)
+        return (StruktsHashmapEntry*)strukts_arena_alloc(hashmap->arena);
+
+    return (StruktsHashmapEntry*)malloc(entry_size(hashmap->flags));
+}
+
+static inline bool entry_has_long_key(const StruktsHashmap* hashmap,
+                                      const StruktsHashmapEntry* entry)
+{
+    /* owned keys that don't fit inline are allocated one by one */
+    return (hashmap->flags & STRUKTS_HASHMAP_OWN_KEYS) &&
+           entry->key_len >= STRUKTS_HASHMAP_INLINE_KEY_SIZE;
+}
+
+static inline void entry_free(StruktsHashmap* hashmap, StruktsHashmapEntry* entry)
+{
+    if (entry_has_long_key(hashmap, entry)) {
+        hashmap->key_bytes -= entry->key_len + 1;
+        free((char*)entry->key);
+    }
+
+    if (hashmap->arena != NULL)
+        strukts_arena_release(hashmap->arena, entry); /* recycled by later additions */
+    else
+        free(entry);
+}
+
+static inline size_t build_task_of(uint32_t hash, size_t capacity, size_t tasks_amount)
+{
+    /* each task owns a contiguous range of buckets */
+    return (hash % capacity) * tasks_amount / capacity;
+}
+
+static inline uint64_t now_ns()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static inline void count_lookups(StruktsHashmap* hashmap, size_t gets, size_t hits,
+                                 size_t comparisons)
+{
+#ifdef STRUKTS_HASHMAP_OP_COUNTERS
+    /* relaxed atomics: concurrent readers (such as of a concurrent hash map's shard) may count */
+    __atomic_fetch_add(&hashmap->op_counters.gets, gets, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hashmap->op_counters.hits, hits, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hashmap->op_counters.misses, gets - hits, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hashmap->op_counters.comparisons, comparisons, __ATOMIC_RELAXED);
+#else
+    (void)hashmap;
+    (void)gets;
+    (void)hits;
+    (void)comparisons;
+#endif
+}
+
+static inline uint64_t reverse_bits(uint64_t bits)
+{
+    bits = ((bits >> 1) & 0x5555555555555555ull) | ((bits & 0x5555555555555555ull) << 1);
+    bits = ((bits >> 2) & 0x3333333333333333ull) | ((bits & 0x3333333333333333ull) << 2);
+    bits = ((bits >> 4) & 0x0f0f0f0f0f0f0f0full) | ((bits & 0x0f0f0f0f0f0f0f0full) << 4);
+
+    return __builtin_bswap64(bits);
+}
+
+static inline uint64_t scan_cursor_next(uint64_t cursor, uint64_t mask)
+{
+    /* bits above the mask are set so that the reversed increment only carries into masked bits */
+    return reverse_bits(reverse_bits(cursor | ~mask) + 1);
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
 static bool is_rehashing_needed(const StruktsHashmap* hashmap)
 {
     /* current load factor = hashmap->size / (float)hashmap->capacity */
     return (float)hashmap->size / (float)hashmap->capacity >= STRUKTS_HASHMAP_MAX_LOAD_FACTOR;
 }
 
-static StruktsHashmap* strukts_hashmap_new_sized(size_t capacity)
+static bool is_shrinking_needed(const StruktsHashmap* hashmap)
+{
+    /* shrinking never interrupts an incremental rehashing which is still in progress */
+    if (!(hashmap->flags & STRUKTS_HASHMAP_SHRINK) || is_rehashing(hashmap))
+        return false;
+
+    return hashmap->capacity > STRUKTS_HASHMAP_INITIAL_CAPACITY &&
+           (float)hashmap->size / (float)hashmap->capacity < STRUKTS_HASHMAP_MIN_LOAD_FACTOR;
+}
+
+static StruktsHashmap* strukts_hashmap_new_sized(size_t capacity, unsigned int flags)
 {
     if (capacity == 0)
         return NULL; /* impossible allocation */
@@ -33,9 +216,19 @@ static StruktsHashmap* strukts_hashmap_new_sized(size_t capacity)
      * strukts_hashmap_free() works fine */
     hashmap->capacity = capacity;
     hashmap->size = 0;
+    hashmap->flags = flags;
+    hashmap->arena = NULL;
+    hashmap->key_bytes = 0;
+    hashmap->bloom_filter = NULL;
+    hashmap->old_capacity = 0;
+    hashmap->old_buckets = NULL;
+    hashmap->rehash_index = 0;
+    hashmap->rehashes = 0;
+    hashmap->rehash_ns = 0;
+    hashmap->op_counters = (StruktsHashmapOpCounters){0, 0, 0, 0};
 
-    /* allocates an array of pointers to buckets lists */
-    hashmap->buckets = (StruktsLinkedList**)malloc(capacity * sizeof(StruktsLinkedList*));
+    /* allocates a zeroed array of chains: NULL buckets are just empty buckets */
+    hashmap->buckets = (StruktsHashmapEntry**)calloc(capacity, sizeof(StruktsHashmapEntry*));
 
     if (hashmap->buckets == NULL) {
         free(hashmap); /* ok to use bare free, nothing else has been allocated */
@@ -43,67 +236,477 @@ static StruktsHashmap* strukts_hashmap_new_sized(size_t capacity)
         return NULL;
     }
 
-    /* initialize array of linked lists to NULL first (trading performance for readability) */
-    for (size_t i = 0; i < capacity; i++) {
-        hashmap->buckets[i] = NULL;
+    /* owned keys' entries come from an arena too: its items are aligned to cache lines */
+    if (flags & (STRUKTS_HASHMAP_ARENA | STRUKTS_HASHMAP_OWN_KEYS)) {
+        hashmap->arena = strukts_arena_new(entry_size(flags), STRUKTS_HASHMAP_ARENA_SLAB_ITEMS);
+
+        if (hashmap->arena == NULL) {
+            strukts_hashmap_free(hashmap);
+
+            return NULL;
+        }
+    }
+
+    return hashmap;
+}
+
+static size_t capacity_for(size_t expected_keys)
+{
+    size_t capacity = STRUKTS_HASHMAP_INITIAL_CAPACITY;
+
+    /* smallest power of 2 that holds all expected keys below the max load factor */
+    while ((float)expected_keys / (float)capacity >= STRUKTS_HASHMAP_MAX_LOAD_FACTOR)
+        capacity *= 2;
+
+    return capacity;
+}
+
+static void buckets_free(StruktsHashmap* hashmap, StruktsHashmapEntry** buckets, size_t capacity)
+{
+    /* arena allocated entries are released at once with the arena's slabs, but their long owned
+     * keys still have to be deallocated one by one */
+    const bool free_entries =
+        hashmap->arena == NULL || (hashmap->flags & STRUKTS_HASHMAP_OWN_KEYS);
+
+    /* deallocates all chains of a bucket array used for collision resolution */
+    for (size_t i = 0; free_entries && i < capacity; i++) {
+        StruktsHashmapEntry* entry = buckets[i];
+
+        while (entry != NULL) {
+            StruktsHashmapEntry* next_entry = entry->next;
+
+            entry_free(hashmap, entry);
+            entry = next_entry;
+        }
+    }
+
+    /* deallocate the array of buckets */
+    free(buckets);
+}
+
+static StruktsHashmapEntry** chain_find(StruktsHashmapEntry** link, const void* key, size_t key_len,
+                                        uint32_t hash, size_t* comparisons)
+{
+    /* returns the link (bucket or previous entry's next) that points to the key's entry so that
+     * entries can be unlinked from singly linked chains */
+    while (*link != NULL) {
+        if (comparisons != NULL)
+            (*comparisons)++;
+
+        if (entry_has_key(*link, key, key_len, hash))
+            return link;
+
+        link = &(*link)->next;
+    }
+
+    return NULL;
+}
+
+static StruktsHashmapEntry** hashmap_find(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                          uint32_t hash, size_t* comparisons)
+{
+    /* modular hashing: the newest bucket array holds the newest keys */
+    StruktsHashmapEntry** link = chain_find(&hashmap->buckets[hash % hashmap->capacity], key,
+                                            key_len, hash, comparisons);
+
+    /* keys of old buckets that have not been migrated yet are still in the old bucket array */
+    if (link == NULL && is_rehashing(hashmap)) {
+        size_t old_bucket_hash = hash % hashmap->old_capacity;
+
+        if (old_bucket_hash >= hashmap->rehash_index)
+            link = chain_find(&hashmap->old_buckets[old_bucket_hash], key, key_len, hash,
+                              comparisons);
+    }
+
+    return link;
+}
+
+static void chain_append(StruktsHashmapEntry** bucket, StruktsHashmapEntry* entry)
+{
+    /* walks to the end of the chain (chains are short for load factors below 1) */
+    while (*bucket != NULL)
+        bucket = &(*bucket)->next;
+
+    entry->next = NULL;
+    *bucket = entry;
+}
+
+static void rehash_bucket(StruktsHashmap* hashmap, size_t old_bucket_hash)
+{
+    StruktsHashmapEntry* entry = hashmap->old_buckets[old_bucket_hash];
+
+    /*
+     * Entries are moved (not reallocated) into the new bucket array using their stored hashes.
+     * Keys added while an incremental rehashing is in progress are newer than any migrated key, so
+     * migrated entries go to the end of the new chains to keep the newest keys first.
+     */
+    while (entry != NULL) {
+        StruktsHashmapEntry* next_entry = entry->next;
+
+        chain_append(&hashmap->buckets[entry->hash % hashmap->capacity], entry);
+        entry = next_entry;
+    }
+
+    hashmap->old_buckets[old_bucket_hash] = NULL;
+}
+
+static void rehash_step(StruktsHashmap* hashmap, size_t steps)
+{
+    /* migrates, at most, 'steps' buckets from the old bucket array to the new one */
+    for (size_t i = 0; i < steps && hashmap->rehash_index < hashmap->old_capacity; i++) {
+        rehash_bucket(hashmap, hashmap->rehash_index);
+        hashmap->rehash_index++;
+    }
+
+    /* old bucket array has been drained: rehashing is over */
+    if (hashmap->rehash_index == hashmap->old_capacity) {
+        free(hashmap->old_buckets);
+
+        hashmap->old_buckets = NULL;
+        hashmap->old_capacity = 0;
+        hashmap->rehash_index = 0;
     }
+}
+
+static void incremental_rehash_step(StruktsHashmap* hashmap)
+{
+    /* steps run on the hot path of every operation: they're only timed along with the lookup
+     * counters, since two clock reads cost more than migrating a few buckets */
+#ifdef STRUKTS_HASHMAP_OP_COUNTERS
+    const uint64_t start = now_ns();
+
+    rehash_step(hashmap, STRUKTS_HASHMAP_REHASH_STEP);
+    hashmap->rehash_ns += now_ns() - start;
+#else
+    rehash_step(hashmap, STRUKTS_HASHMAP_REHASH_STEP);
+#endif
+}
+
+static bool rehash_start(StruktsHashmap* hashmap, size_t new_capacity)
+{
+    StruktsHashmapEntry** new_buckets =
+        (StruktsHashmapEntry**)calloc(new_capacity, sizeof(StruktsHashmapEntry*));
+
+    if (new_buckets == NULL)
+        return false; /* reallocation has failed */
+
+    /* the current bucket array becomes the old one which will be drained bucket by bucket */
+    hashmap->old_buckets = hashmap->buckets;
+    hashmap->old_capacity = hashmap->capacity;
+    hashmap->rehash_index = 0;
+
+    hashmap->buckets = new_buckets;
+    hashmap->capacity = new_capacity;
+    hashmap->rehashes++;
+
+    return true;
+}
+
+static bool rehash(StruktsHashmap* hashmap, size_t new_capacity)
+{
+    const uint64_t start = now_ns();
+
+    /* an unfinished incremental rehashing must be over before a new one begins */
+    if (is_rehashing(hashmap))
+        rehash_step(hashmap, hashmap->old_capacity);
+
+    bool started = rehash_start(hashmap, new_capacity);
+
+    /* rehash all keys of the old bucket array at once or a few buckets on later operations */
+    if (started && !(hashmap->flags & STRUKTS_HASHMAP_INCREMENTAL_REHASH))
+        rehash_step(hashmap, hashmap->old_capacity);
+
+    hashmap->rehash_ns += now_ns() - start;
 
+    return started;
+}
+
+static void scan_chain(const StruktsHashmapEntry* entry,
+                       void (*visit)(const StruktsHashmapEntry*, void*), void* context)
+{
+    for (; entry != NULL; entry = entry->next)
+        visit(entry, context);
+}
+
+static void chains_stats(StruktsHashmapEntry* const* buckets, size_t capacity,
+                         StruktsHashmapStats* stats)
+{
     for (size_t i = 0; i < capacity; i++) {
-        StruktsLinkedList* list = strukts_linkedlist_new();
+        size_t chain_length = 0;
+
+        for (const StruktsHashmapEntry* entry = buckets[i]; entry != NULL; entry = entry->next)
+            chain_length++;
+
+        if (chain_length > stats->longest_chain)
+            stats->longest_chain = chain_length;
+
+        if (chain_length >= STRUKTS_HASHMAP_STATS_CHAINS)
+            chain_length = STRUKTS_HASHMAP_STATS_CHAINS - 1;
+
+        stats->chain_lengths[chain_length]++;
+    }
+}
+
+static const char* entry_copy_key(StruktsHashmap* hashmap, StruktsHashmapEntry* entry,
+                                  const char* key, size_t key_len)
+{
+    /* short keys live right after their entry: no other cache line is read to compare them */
+    if (key_len < STRUKTS_HASHMAP_INLINE_KEY_SIZE) {
+        char* inline_key = (char*)(entry + 1);
+
+        memcpy(inline_key, key, key_len);
+        inline_key[key_len] = '\0';
+
+        return inline_key;
+    }
+
+    char* long_key = (char*)malloc(key_len + 1);
+
+    if (long_key == NULL)
+        return NULL;
+
+    memcpy(long_key, key, key_len);
+    long_key[key_len] = '\0';
+    hashmap->key_bytes += key_len + 1;
+
+    return long_key;
+}
+
+static bool hashmap_insert(StruktsHashmap* hashmap, const char* key, size_t key_len, uint32_t hash,
+                           uint32_t upper_hash, char* value)
+{
+    /* allocate bigger bucket array and rehash keys */
+    if (is_rehashing_needed(hashmap) && !rehash(hashmap, 2 * hashmap->capacity))
+        return false;
+
+    StruktsHashmapEntry* entry = entry_new(hashmap);
+
+    if (entry == NULL)
+        return false;
+
+    if (hashmap->flags & STRUKTS_HASHMAP_OWN_KEYS) {
+        key = entry_copy_key(hashmap, entry, key, key_len);
+
+        if (key == NULL) {
+            strukts_arena_release(hashmap->arena, entry); /* owned keys' entries are arena items */
+
+            return false;
+        }
+    }
+
+    entry->key = key;
+    entry->value = value;
+    entry->key_len = key_len;
+    entry->hash = hash;
 
-        /* if an allocation error happens here, stop and free everything so far */
-        if (list == NULL) {
-            strukts_hashmap_free(hashmap); /* requires hashmap->capacity initialization */
+    if (hashmap->bloom_filter != NULL) {
+        const uint32_t alt_hash = alt_hash_key(hashmap, key, key_len, upper_hash);
+
+        strukts_bloom_filter_add_hashes(hashmap->bloom_filter, hash, alt_hash);
+    }
+
+    /* modular hashing: new keys always go to the beginning of the newest bucket array's chains */
+    StruktsHashmapEntry** bucket = &hashmap->buckets[hash % hashmap->capacity];
+
+    entry->next = *bucket;
+    *bucket = entry;
+
+    /* metadata updating */
+    hashmap->size++;
+
+    return true;
+}
+
+static void* build_hash_keys(void* build_task)
+{
+    StruktsHashmapBuildTask* task = (StruktsHashmapBuildTask*)build_task;
+
+    uint32_t upper_hash;
+
+    for (size_t i = task->from; i < task->to; i++) {
+        task->key_lens[i] = strlen(task->keys[i]);
+        task->key_hashes[i] =
+            hash_key(task->hashmap, task->keys[i], task->key_lens[i], &upper_hash);
+    }
+
+    return NULL;
+}
+
+static void* build_fill_buckets(void* build_task)
+{
+    StruktsHashmapBuildTask* task = (StruktsHashmapBuildTask*)build_task;
+    StruktsHashmap* hashmap = task->hashmap;
+
+    for (size_t k = task->from; k < task->to; k++) {
+        const size_t i = task->key_order != NULL ? task->key_order[k] : k;
+        const size_t bucket_hash = task->key_hashes[i] % hashmap->capacity;
+        StruktsHashmapEntry* entry = entry_new(hashmap);
+
+        if (entry == NULL) {
+            task->failed = true;
 
             return NULL;
         }
 
-        hashmap->buckets[i] = list;
+        entry->key = task->keys[i];
+        entry->value = task->values[i];
+        entry->key_len = task->key_lens[i];
+        entry->hash = task->key_hashes[i];
+
+        /* later keys go first, just like strukts_hashmap_add */
+        entry->next = hashmap->buckets[bucket_hash];
+        hashmap->buckets[bucket_hash] = entry;
     }
 
-    return hashmap;
+    return NULL;
 }
 
-static StruktsHashmap* rehash(const StruktsHashmap* old_hashmap)
+static void build_partition_keys(StruktsHashmapBuildTask* tasks, size_t tasks_amount, size_t n)
 {
-    StruktsLinkedList* list;
-    StruktsLinkedListNode* current_node;
-    StruktsHashmap* new_hashmap = strukts_hashmap_new_sized(2 * old_hashmap->capacity);
+    const uint32_t* key_hashes = tasks[0].key_hashes;
+    const size_t capacity = tasks[0].hashmap->capacity;
+    size_t next[STRUKTS_HASHMAP_BUILD_MAX_THREADS] = {0};
+
+    if (tasks_amount == 1) {
+        tasks[0].from = 0;
+        tasks[0].to = n;
 
-    if (new_hashmap == NULL)
-        return NULL; /* reallocation has failed */
+        return;
+    }
 
-    /* rehash previous keys of the bucket lists into the new_hashmap */
-    for (size_t i = 0; i < old_hashmap->size; i++) {
-        list = old_hashmap->buckets[i];
+    /* counting sort of the keys by the task that owns their bucket: counts, offsets and scatter */
+    for (size_t i = 0; i < n; i++)
+        next[build_task_of(key_hashes[i], capacity, tasks_amount)]++;
 
-        if (list == NULL || list->size < 1)
-            continue; /* list must exists and not be empty */
+    for (size_t t = 0, from = 0; t < tasks_amount; t++) {
+        tasks[t].from = from;
+        tasks[t].to = from + next[t];
+        next[t] = from;
+        from = tasks[t].to;
+    }
 
-        current_node = list->first_node;
+    /* stable: a task still links its keys in their original order */
+    for (size_t i = 0; i < n; i++)
+        tasks[0].key_order[next[build_task_of(key_hashes[i], capacity, tasks_amount)]++] = i;
+}
 
-        /* traverse each bucket's linked list of values */
-        while (current_node != NULL) {
-            /* rehash each key according to the new hashmap's capacity */
-            bool added = strukts_hashmap_add(&new_hashmap, current_node->key, current_node->value);
+static bool build_run(StruktsHashmapBuildTask* tasks, size_t tasks_amount,
+                      void* (*build_step)(void*))
+{
+    pthread_t threads[STRUKTS_HASHMAP_BUILD_MAX_THREADS];
+    bool started[STRUKTS_HASHMAP_BUILD_MAX_THREADS];
+    bool failed = false;
 
-            /* rehashing failed to add all keys: free any allocated memory and return */
-            if (!added) {
-                strukts_hashmap_free(new_hashmap);
+    /* the calling thread runs the first task itself */
+    for (size_t t = 1; t < tasks_amount; t++)
+        started[t] = pthread_create(&threads[t], NULL, build_step, &tasks[t]) == 0;
 
-                return NULL;
-            }
+    build_step(&tasks[0]);
 
-            current_node = current_node->next;
-        }
+    for (size_t t = 1; t < tasks_amount; t++) {
+        if (started[t])
+            pthread_join(threads[t], NULL);
+        else
+            build_step(&tasks[t]); /* no thread could be created: the task runs here */
     }
 
-    return new_hashmap;
+    for (size_t t = 0; t < tasks_amount; t++)
+        failed = failed || tasks[t].failed;
+
+    return !failed;
 }
 
+/********************** PUBLIC FUNCTIONS **********************/
 StruktsHashmap* strukts_hashmap_new()
 {
-    return strukts_hashmap_new_sized(STRUKTS_HASHMAP_INITIAL_CAPACITY);
+    return strukts_hashmap_new_sized(STRUKTS_HASHMAP_INITIAL_CAPACITY, STRUKTS_HASHMAP_DEFAULT);
+}
+
+StruktsHashmap* strukts_hashmap_new_with_flags(unsigned int flags)
+{
+    return strukts_hashmap_new_sized(STRUKTS_HASHMAP_INITIAL_CAPACITY, flags);
+}
+
+StruktsHashmap* strukts_hashmap_new_with_capacity(size_t expected_keys)
+{
+    return strukts_hashmap_new_sized(capacity_for(expected_keys), STRUKTS_HASHMAP_DEFAULT);
+}
+
+StruktsHashmap* strukts_hashmap_build(const char* const keys[], char* const values[], size_t n,
+                                      size_t threads_amount)
+{
+    StruktsHashmap* hashmap = strukts_hashmap_new_with_capacity(n);
+
+    if (hashmap == NULL || n == 0)
+        return hashmap;
+
+    if (threads_amount == 0)
+        threads_amount = 1;
+
+    if (threads_amount > STRUKTS_HASHMAP_BUILD_MAX_THREADS)
+        threads_amount = STRUKTS_HASHMAP_BUILD_MAX_THREADS;
+
+    /* a single thread links the keys in their original order: no partitioning is needed */
+    size_t* key_lens = (size_t*)malloc(n * sizeof(size_t));
+    uint32_t* key_hashes = (uint32_t*)malloc(n * sizeof(uint32_t));
+    size_t* key_order = threads_amount > 1 ? (size_t*)malloc(n * sizeof(size_t)) : NULL;
+
+    if (key_lens == NULL || key_hashes == NULL || (threads_amount > 1 && key_order == NULL)) {
+        free(key_lens);
+        free(key_hashes);
+        free(key_order);
+        strukts_hashmap_free(hashmap);
+
+        return NULL;
+    }
+
+    StruktsHashmapBuildTask tasks[STRUKTS_HASHMAP_BUILD_MAX_THREADS];
+
+    for (size_t t = 0; t < threads_amount; t++) {
+        tasks[t] = (StruktsHashmapBuildTask){.hashmap = hashmap,
+                                             .keys = keys,
+                                             .values = values,
+                                             .key_lens = key_lens,
+                                             .key_hashes = key_hashes,
+                                             .key_order = key_order,
+                                             .from = n * t / threads_amount,
+                                             .to = n * (t + 1) / threads_amount,
+                                             .failed = false};
+    }
+
+    /* pass 1: hashes slices of the keys */
+    build_run(tasks, threads_amount, build_hash_keys);
+
+    /* pass 2: fills slices of the (already sized) bucket array: no rehashing ever happens. Keys
+     * are partitioned once so that each thread only walks the keys of its own buckets */
+    build_partition_keys(tasks, threads_amount, n);
+
+    bool built = build_run(tasks, threads_amount, build_fill_buckets);
+
+    free(key_lens);
+    free(key_hashes);
+    free(key_order);
+
+    if (!built) {
+        strukts_hashmap_free(hashmap); /* entries linked so far are deallocated with the chains */
+
+        return NULL;
+    }
+
+    hashmap->size = n;
+
+    return hashmap;
+}
+
+bool strukts_hashmap_reserve(StruktsHashmap* hashmap, size_t expected_keys)
+{
+    size_t capacity = capacity_for(expected_keys);
+
+    /* never shrinks: a bigger bucket array already holds the expected keys */
+    if (capacity <= hashmap->capacity)
+        return true;
+
+    return rehash(hashmap, capacity);
 }
 
 void strukts_hashmap_free(StruktsHashmap* hashmap)
@@ -111,82 +714,401 @@ void strukts_hashmap_free(StruktsHashmap* hashmap)
     if (hashmap == NULL)
         return;
 
-    StruktsLinkedList* list;
-
-    /* deallocates all linked lists of the current hashmap used for collision resolution. Notice
-     * that if hashmap != NULL, hashmap->capacity is ALWAYS initialized and hashmap->buckets TOO! */
-    for (size_t i = 0; i < hashmap->capacity; i++) {
-        list = hashmap->buckets[i];  // grab a pointer to a linked list
+    /* notice that if hashmap != NULL, hashmap->capacity is ALWAYS initialized and
+     * hashmap->buckets TOO! */
+    buckets_free(hashmap, hashmap->buckets, hashmap->capacity);
 
-        /* asserts this bucket's index holds a list */
-        if (list != NULL)
-            strukts_linkedlist_free(list);
-    }
+    /* some keys may still live in the old bucket array of an unfinished rehashing */
+    if (is_rehashing(hashmap))
+        buckets_free(hashmap, hashmap->old_buckets, hashmap->old_capacity);
 
-    /* deallocate the array of bucket lists */
-    free(hashmap->buckets);
+    strukts_arena_free(hashmap->arena);
+    strukts_bloom_filter_free(hashmap->bloom_filter);
 
     /* deallocate the current hashmap struct pointer*/
     free(hashmap);
 }
 
-bool strukts_hashmap_add(StruktsHashmap** hashmap_ptr, const char* key, char* value)
+uint64_t strukts_hashmap_hash_key(const StruktsHashmap* hashmap, const void* key, size_t key_len)
 {
-    if (is_rehashing_needed(*hashmap_ptr)) {
-        /* reallocate bigger hash table and rehash all keys */
-        StruktsHashmap* resized_hashmap = rehash(*hashmap_ptr);
+    uint32_t upper_hash;
+    const uint32_t key_hash = hash_key(hashmap, key, key_len, &upper_hash);
 
-        /* rehashing reallocation failed */
-        if (resized_hashmap == NULL)
-            return false;
+    return ((uint64_t)upper_hash << 32) | key_hash;
+}
+
+bool strukts_hashmap_add(StruktsHashmap* hashmap, const char* key, char* value)
+{
+    return strukts_hashmap_add_n(hashmap, key, strlen(key), value);
+}
+
+bool strukts_hashmap_add_n(StruktsHashmap* hashmap, const void* key, size_t key_len, char* value)
+{
+    /* incremental rehashing: pays a constant amount of rehashing work on every operation */
+    if (is_rehashing(hashmap))
+        incremental_rehash_step(hashmap);
+
+    uint32_t upper_hash;
+    const uint32_t key_hash = hash_key(hashmap, key, key_len, &upper_hash);
+
+    return hashmap_insert(hashmap, (const char*)key, key_len, key_hash, upper_hash, value);
+}
+
+bool strukts_hashmap_upsert(StruktsHashmap* hashmap, const char* key, char* value)
+{
+    return strukts_hashmap_upsert_n(hashmap, key, strlen(key), value);
+}
+
+bool strukts_hashmap_upsert_n(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                              char* value)
+{
+    return strukts_hashmap_upsert_hashed(hashmap, key, key_len,
+                                         strukts_hashmap_hash_key(hashmap, key, key_len), value);
+}
+
+bool strukts_hashmap_upsert_hashed(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                   uint64_t key_hashes, char* value)
+{
+    const uint32_t key_hash = (uint32_t)key_hashes;
+
+    if (is_rehashing(hashmap))
+        incremental_rehash_step(hashmap);
+
+    StruktsHashmapEntry** link = hashmap_find(hashmap, key, key_len, key_hash, NULL);
 
-        /* free old hashmap and point to the newly allocated hashmap */
-        strukts_hashmap_free(*hashmap_ptr);
-        *hashmap_ptr = resized_hashmap;
+    /* existing keys have their values replaced in place */
+    if (link != NULL) {
+        (*link)->value = value;
+
+        return true;
     }
 
-    const uint8_t* key_bytes = (const uint8_t*)key;
-    const size_t key_len = strlen(key);
-    const uint32_t seed = 0;
+    return hashmap_insert(hashmap, (const char*)key, key_len, key_hash,
+                          (uint32_t)(key_hashes >> 32), value);
+}
+
+bool strukts_hashmap_remove(StruktsHashmap* hashmap, const char* key)
+{
+    return strukts_hashmap_remove_n(hashmap, key, strlen(key));
+}
 
-    StruktsHashmap* hashmap = *hashmap_ptr; /* possibly with newly allocated hashmap */
+bool strukts_hashmap_remove_n(StruktsHashmap* hashmap, const void* key, size_t key_len)
+{
+    return strukts_hashmap_remove_hashed(hashmap, key, key_len,
+                                         strukts_hashmap_hash_key(hashmap, key, key_len));
+}
 
-    /* modular hashing */
-    uint32_t key_hash = strukts_murmur3_hash(key_bytes, key_len, seed);
-    size_t bucket_hash = key_hash % hashmap->capacity;
+bool strukts_hashmap_remove_hashed(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                   uint64_t key_hashes)
+{
+    if (is_rehashing(hashmap))
+        incremental_rehash_step(hashmap);
 
-    /* separate chaining for hashing collisions resolution */
-    StruktsLinkedList* list = hashmap->buckets[bucket_hash];
-    bool added = strukts_linkedlist_append(list, key, value);
+    StruktsHashmapEntry** link = hashmap_find(hashmap, key, key_len, (uint32_t)key_hashes, NULL);
 
-    /* in the worst case scenario, hashmap is reallocated (bigger) and new addition failed */
-    if (!added)
+    if (link == NULL)
         return false;
 
-    /* metadata updating */
-    hashmap->size++;
+    /* unlinks the entry from its chain */
+    StruktsHashmapEntry* entry = *link;
+
+    *link = entry->next;
+    entry_free(hashmap, entry);
+    hashmap->size--;
+
+    /* a failed shrinking just keeps the current (bigger) bucket array */
+    if (is_shrinking_needed(hashmap))
+        rehash(hashmap, hashmap->capacity / 2);
 
     return true;
 }
 
-char* strukts_hashmap_get(const StruktsHashmap* hashmap, const char* key)
+char* strukts_hashmap_get(StruktsHashmap* hashmap, const char* key)
 {
-    const uint8_t* key_bytes = (const uint8_t*)key;
-    const size_t key_len = strlen(key);
-    const uint32_t seed = 0;
+    return strukts_hashmap_get_n(hashmap, key, strlen(key));
+}
 
-    StruktsLinkedList* list;
-    StruktsLinearSearchResult search_result;
+char* strukts_hashmap_get_n(StruktsHashmap* hashmap, const void* key, size_t key_len)
+{
+    return strukts_hashmap_get_hashed(hashmap, key, key_len,
+                                      strukts_hashmap_hash_key(hashmap, key, key_len));
+}
+
+char* strukts_hashmap_get_hashed(StruktsHashmap* hashmap, const void* key, size_t key_len,
+                                 uint64_t key_hashes)
+{
+    const uint32_t key_hash = (uint32_t)key_hashes;
+
+    if (is_rehashing(hashmap))
+        incremental_rehash_step(hashmap);
+
+    /* keys rejected by the filter are surely missing: no bucket is read */
+    if (is_rejected_by_filter(hashmap, key, key_len, key_hash, (uint32_t)(key_hashes >> 32))) {
+        count_lookups(hashmap, 1, 0, 0);
+
+        return NULL;
+    }
 
-    /* modular hashing */
-    uint32_t key_hash = strukts_murmur3_hash(key_bytes, key_len, seed);
-    size_t bucket_hash = key_hash % hashmap->capacity;
+    size_t comparisons = 0;
+    StruktsHashmapEntry** link = hashmap_find(hashmap, key, key_len, key_hash, &comparisons);
 
-    list = hashmap->buckets[bucket_hash];
-    search_result = strukts_linkedlist_find(list, key);
+    count_lookups(hashmap, 1, link != NULL, comparisons);
 
-    if (!search_result.found)
+    if (link == NULL)
         return NULL;
 
-    return search_result.node->value;
-}
\ No newline at end of file
+    return (*link)->value;
+}
+
+size_t strukts_hashmap_get_many(StruktsHashmap* hashmap, const char* const keys[], size_t n,
+                                char* values[])
+{
+    size_t key_lens[STRUKTS_HASHMAP_GET_MANY_BATCH];
+    uint32_t key_hashes[STRUKTS_HASHMAP_GET_MANY_BATCH];
+    uint32_t upper_hashes[STRUKTS_HASHMAP_GET_MANY_BATCH];
+    StruktsHashmapEntry** buckets[STRUKTS_HASHMAP_GET_MANY_BATCH];
+    StruktsHashmapEntry* entries[STRUKTS_HASHMAP_GET_MANY_BATCH];
+    bool hits[STRUKTS_HASHMAP_GET_MANY_BATCH];
+    size_t found = 0;
+    size_t comparisons = 0;
+
+    if (is_rehashing(hashmap))
+        incremental_rehash_step(hashmap);
+
+    for (size_t start = 0; start < n; start += STRUKTS_HASHMAP_GET_MANY_BATCH) {
+        const char* const* batch_keys = keys + start;
+        char** batch_values = values + start;
+        size_t batch = n - start;
+
+        if (batch > STRUKTS_HASHMAP_GET_MANY_BATCH)
+            batch = STRUKTS_HASHMAP_GET_MANY_BATCH;
+
+        /* stage 1: hashes all keys and prefetches their buckets (unless the filter rejects them) */
+        for (size_t i = 0; i < batch; i++) {
+            key_lens[i] = strlen(batch_keys[i]);
+            key_hashes[i] = hash_key(hashmap, batch_keys[i], key_lens[i], &upper_hashes[i]);
+            buckets[i] = &hashmap->buckets[key_hashes[i] % hashmap->capacity];
+
+            if (is_rejected_by_filter(hashmap, batch_keys[i], key_lens[i], key_hashes[i],
+                                      upper_hashes[i]))
+                buckets[i] = NULL;
+            else
+                PREFETCH(buckets[i]);
+        }
+
+        /* stage 2: loads the first entries of all chains (already in flight) and prefetches them */
+        for (size_t i = 0; i < batch; i++) {
+            entries[i] = buckets[i] != NULL ? *buckets[i] : NULL;
+            batch_values[i] = NULL;
+            hits[i] = false;
+
+            if (entries[i] != NULL)
+                PREFETCH(entries[i]);
+        }
+
+        /* stage 3: walks all chains one entry at a time until every key is found or missing */
+        for (size_t pending = batch; pending > 0;) {
+            pending = 0;
+
+            for (size_t i = 0; i < batch; i++) {
+                StruktsHashmapEntry* entry = entries[i];
+
+                if (entry == NULL)
+                    continue;
+
+                comparisons++;
+
+                if (entry_has_key(entry, batch_keys[i], key_lens[i], key_hashes[i])) {
+                    batch_values[i] = entry->value;
+                    hits[i] = true;
+                    entries[i] = NULL;
+                    found++;
+
+                    continue;
+                }
+
+                entries[i] = entry->next;
+
+                if (entries[i] != NULL) {
+                    PREFETCH(entries[i]);
+                    pending++;
+                }
+            }
+        }
+
+        /* keys missing from the newest bucket array may still be in not migrated old buckets (the
+         * new chains were already walked above, so only the old ones are) */
+        for (size_t i = 0; is_rehashing(hashmap) && i < batch; i++) {
+            const size_t old_bucket_hash = key_hashes[i] % hashmap->old_capacity;
+
+            if (hits[i] || buckets[i] == NULL || old_bucket_hash < hashmap->rehash_index)
+                continue;
+
+            StruktsHashmapEntry** link =
+                chain_find(&hashmap->old_buckets[old_bucket_hash], batch_keys[i], key_lens[i],
+                           key_hashes[i], &comparisons);
+
+            if (link != NULL) {
+                batch_values[i] = (*link)->value;
+                found++;
+            }
+        }
+    }
+
+    count_lookups(hashmap, n, found, comparisons);
+
+    return found;
+}
+
+void strukts_hashmap_iterator_init(StruktsHashmapIterator* iterator, const StruktsHashmap* hashmap)
+{
+    iterator->hashmap = hashmap;
+    iterator->entry = NULL;
+
+    /* old buckets before rehash_index have already been drained into the newest bucket array */
+    if (is_rehashing(hashmap)) {
+        iterator->buckets = hashmap->old_buckets;
+        iterator->capacity = hashmap->old_capacity;
+        iterator->bucket = hashmap->rehash_index;
+    } else {
+        iterator->buckets = hashmap->buckets;
+        iterator->capacity = hashmap->capacity;
+        iterator->bucket = 0;
+    }
+}
+
+const StruktsHashmapEntry* strukts_hashmap_iterator_next(StruktsHashmapIterator* iterator)
+{
+    while (iterator->entry == NULL) {
+        if (iterator->bucket == iterator->capacity) {
+            if (iterator->buckets == iterator->hashmap->buckets)
+                return NULL; /* the newest bucket array is always the last one */
+
+            iterator->buckets = iterator->hashmap->buckets;
+            iterator->capacity = iterator->hashmap->capacity;
+            iterator->bucket = 0;
+
+            continue;
+        }
+
+        iterator->entry = iterator->buckets[iterator->bucket++];
+    }
+
+    const StruktsHashmapEntry* entry = iterator->entry;
+
+    iterator->entry = entry->next;
+
+    return entry;
+}
+
+uint64_t strukts_hashmap_scan(const StruktsHashmap* hashmap, uint64_t cursor,
+                              void (*visit)(const StruktsHashmapEntry*, void*), void* context)
+{
+    /* capacities are powers of 2: the bucket of a hash is given by its lowest bits (hash & mask) */
+    if (!is_rehashing(hashmap)) {
+        const uint64_t mask = hashmap->capacity - 1;
+
+        scan_chain(hashmap->buckets[cursor & mask], visit, context);
+
+        return scan_cursor_next(cursor, mask);
+    }
+
+    StruktsHashmapEntry** small_buckets = hashmap->old_buckets;
+    StruktsHashmapEntry** large_buckets = hashmap->buckets;
+    uint64_t small_mask = hashmap->old_capacity - 1;
+    uint64_t large_mask = hashmap->capacity - 1;
+
+    /* shrinking: the newest bucket array is the smaller one */
+    if (small_mask > large_mask) {
+        small_buckets = hashmap->buckets;
+        large_buckets = hashmap->old_buckets;
+        small_mask = hashmap->capacity - 1;
+        large_mask = hashmap->old_capacity - 1;
+    }
+
+    /* drained old buckets are empty, so both arrays can be scanned regardless of rehash_index */
+    scan_chain(small_buckets[cursor & small_mask], visit, context);
+
+    /* visits all buckets of the larger array whose keys would be in the small array's bucket */
+    do {
+        scan_chain(large_buckets[cursor & large_mask], visit, context);
+        cursor = scan_cursor_next(cursor, large_mask);
+    } while (cursor & (small_mask ^ large_mask));
+
+    return cursor;
+}
+
+bool strukts_hashmap_attach_bloom_filter(StruktsHashmap* hashmap, size_t expected_keys,
+                                         double false_positive_rate, unsigned int bloom_flags)
+{
+    /* the filter hashes keys just like the hash map, so it can be queried on its own as well */
+    bloom_flags &= ~STRUKTS_BLOOM_FILTER_MURMUR3_128;
+
+    if (hashmap->flags & STRUKTS_HASHMAP_MURMUR3_128)
+        bloom_flags |= STRUKTS_BLOOM_FILTER_MURMUR3_128;
+
+    StruktsBloomFilter* filter =
+        strukts_bloom_filter_new(expected_keys, false_positive_rate, bloom_flags);
+    StruktsHashmapIterator iterator;
+
+    if (filter == NULL)
+        return false;
+
+    strukts_hashmap_iterator_init(&iterator, hashmap);
+
+    for (const StruktsHashmapEntry* entry = strukts_hashmap_iterator_next(&iterator); entry != NULL;
+         entry = strukts_hashmap_iterator_next(&iterator)) {
+        uint32_t upper_hash;
+
+        /* entries only keep the lower 32 bits of their hash: 128-bit keys are hashed again */
+        hash_key(hashmap, entry->key, entry->key_len, &upper_hash);
+        strukts_bloom_filter_add_hashes(
+            filter, entry->hash, alt_hash_key(hashmap, entry->key, entry->key_len, upper_hash));
+    }
+
+    strukts_bloom_filter_free(hashmap->bloom_filter);
+    hashmap->bloom_filter = filter;
+
+    return true;
+}
+
+StruktsHashmapStats strukts_hashmap_stats(const StruktsHashmap* hashmap)
+{
+    StruktsHashmapStats stats;
+
+    memset(&stats, 0, sizeof(StruktsHashmapStats));
+
+    /* while rehashing, keys are spread over both bucket arrays (drained old buckets are empty) */
+    chains_stats(hashmap->buckets, hashmap->capacity, &stats);
+
+    if (is_rehashing(hashmap))
+        chains_stats(hashmap->old_buckets, hashmap->old_capacity, &stats);
+
+    stats.size = hashmap->size;
+    stats.capacity = hashmap->capacity + hashmap->old_capacity;
+    stats.load_factor = (double)stats.size / (double)stats.capacity;
+    stats.empty_buckets = stats.chain_lengths[0];
+    stats.rehashes = hashmap->rehashes;
+    stats.rehash_ns = hashmap->rehash_ns;
+
+    /* entries: whole arena slabs or one (unpadded) malloc per entry */
+    stats.allocated_bytes = sizeof(StruktsHashmap) + stats.capacity * sizeof(StruktsHashmapEntry*);
+
+    if (hashmap->arena != NULL)
+        stats.allocated_bytes += strukts_arena_allocated_bytes(hashmap->arena);
+    else
+        stats.allocated_bytes += hashmap->size * entry_size(hashmap->flags);
+
+    stats.allocated_bytes += hashmap->key_bytes;
+
+    if (hashmap->bloom_filter != NULL)
+        stats.allocated_bytes += hashmap->bloom_filter->bits_amount / 8;
+
+    stats.op_counters.gets = __atomic_load_n(&hashmap->op_counters.gets, __ATOMIC_RELAXED);
+    stats.op_counters.hits = __atomic_load_n(&hashmap->op_counters.hits, __ATOMIC_RELAXED);
+    stats.op_counters.misses = __atomic_load_n(&hashmap->op_counters.misses, __ATOMIC_RELAXED);
+    stats.op_counters.comparisons =
+        __atomic_load_n(&hashmap->op_counters.comparisons, __ATOMIC_RELAXED);
+
+    return stats;
+}
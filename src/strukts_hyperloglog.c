@@ -0,0 +1,268 @@
+#include "strukts_hyperloglog.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define calloc sf_calloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define SPARSE_INITIAL_CAPACITY 8
+#define SPARSE_INDEX(sparse_register) ((sparse_register) >> 8)
+#define SPARSE_VALUE(sparse_register) ((uint8_t)((sparse_register)&0xff))
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint64_t hash_key(const void* key, size_t key_len)
+{
+    uint64_t hash[2];
+
+    strukts_murmur3_hash_x64_128((const uint8_t*)key, key_len, STRUKTS_HYPERLOGLOG_SEED, hash);
+
+    return hash[0];
+}
+
+static inline size_t sparse_limit(const StruktsHyperLogLog* hll)
+{
+    /* sparse registers take 4 bytes each: at m / 4 of them, they take as much as dense ones */
+    return hll->registers_amount / 4;
+}
+
+static inline double alpha(size_t registers_amount)
+{
+    switch (registers_amount) {
+        case 16:
+            return 0.673;
+        case 32:
+            return 0.697;
+        case 64:
+            return 0.709;
+        default:
+            return 0.7213 / (1 + 1.079 / (double)registers_amount);
+    }
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static bool to_dense(StruktsHyperLogLog* hll)
+{
+    uint8_t* registers = (uint8_t*)calloc(hll->registers_amount, sizeof(uint8_t));
+
+    if (registers == NULL)
+        return false;
+
+    for (size_t i = 0; i < hll->sparse_amount; i++)
+        registers[SPARSE_INDEX(hll->sparse_registers[i])] =
+            SPARSE_VALUE(hll->sparse_registers[i]);
+
+    free(hll->sparse_registers);
+    hll->sparse_registers = NULL;
+    hll->sparse_amount = 0;
+    hll->sparse_capacity = 0;
+    hll->registers = registers;
+    hll->sparse = false;
+
+    return true;
+}
+
+static bool sparse_grow(StruktsHyperLogLog* hll)
+{
+    size_t capacity = hll->sparse_capacity * 2;
+
+    if (capacity > sparse_limit(hll))
+        capacity = sparse_limit(hll);
+
+    uint32_t* sparse_registers = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+
+    if (sparse_registers == NULL)
+        return false;
+
+    memcpy(sparse_registers, hll->sparse_registers, hll->sparse_amount * sizeof(uint32_t));
+    free(hll->sparse_registers);
+
+    hll->sparse_registers = sparse_registers;
+    hll->sparse_capacity = capacity;
+
+    return true;
+}
+
+static bool set_register(StruktsHyperLogLog* hll, uint32_t index, uint8_t value)
+{
+    if (!hll->sparse) {
+        if (hll->registers[index] < value)
+            hll->registers[index] = value;
+
+        return true;
+    }
+
+    /* binary search for the sparse register (or for the position where it should be inserted) */
+    size_t low = 0;
+    size_t high = hll->sparse_amount;
+
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+
+        if (SPARSE_INDEX(hll->sparse_registers[middle]) < index)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (low < hll->sparse_amount && SPARSE_INDEX(hll->sparse_registers[low]) == index) {
+        if (SPARSE_VALUE(hll->sparse_registers[low]) < value)
+            hll->sparse_registers[low] = (index << 8) | value;
+
+        return true;
+    }
+
+    if (hll->sparse_amount == sparse_limit(hll)) {
+        if (!to_dense(hll))
+            return false;
+
+        return set_register(hll, index, value);
+    }
+
+    if (hll->sparse_amount == hll->sparse_capacity && !sparse_grow(hll))
+        return false;
+
+    memmove(&hll->sparse_registers[low + 1], &hll->sparse_registers[low],
+            (hll->sparse_amount - low) * sizeof(uint32_t));
+    hll->sparse_registers[low] = (index << 8) | value;
+    hll->sparse_amount++;
+
+    return true;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsHyperLogLog* strukts_hyperloglog_new(unsigned int precision)
+{
+    if (precision < STRUKTS_HYPERLOGLOG_MIN_PRECISION ||
+        precision > STRUKTS_HYPERLOGLOG_MAX_PRECISION)
+        return NULL;
+
+    StruktsHyperLogLog* hll = (StruktsHyperLogLog*)malloc(sizeof(StruktsHyperLogLog));
+
+    if (hll == NULL)
+        return NULL;
+
+    hll->precision = precision;
+    hll->registers_amount = (size_t)1 << precision;
+    hll->sparse = true;
+    hll->sparse_amount = 0;
+    hll->sparse_capacity = SPARSE_INITIAL_CAPACITY;
+    hll->registers = NULL;
+
+    if (hll->sparse_capacity > sparse_limit(hll))
+        hll->sparse_capacity = sparse_limit(hll);
+
+    hll->sparse_registers = (uint32_t*)malloc(hll->sparse_capacity * sizeof(uint32_t));
+
+    if (hll->sparse_registers == NULL) {
+        free(hll);
+
+        return NULL;
+    }
+
+    return hll;
+}
+
+void strukts_hyperloglog_free(StruktsHyperLogLog* hll)
+{
+    if (hll == NULL)
+        return;
+
+    free(hll->sparse_registers);
+    free(hll->registers);
+    free(hll);
+}
+
+bool strukts_hyperloglog_add(StruktsHyperLogLog* hll, const char* key)
+{
+    return strukts_hyperloglog_add_hash(hll, hash_key(key, strlen(key)));
+}
+
+bool strukts_hyperloglog_add_n(StruktsHyperLogLog* hll, const void* key, size_t key_len)
+{
+    return strukts_hyperloglog_add_hash(hll, hash_key(key, key_len));
+}
+
+bool strukts_hyperloglog_add_hash(StruktsHyperLogLog* hll, uint64_t hash)
+{
+    /* first p bits: register index; remaining bits: position of their first 1 bit */
+    const uint32_t index = (uint32_t)(hash >> (64 - hll->precision));
+    const uint64_t remaining = hash << hll->precision;
+    const uint8_t value = remaining == 0 ? (uint8_t)(64 - hll->precision + 1)
+                                         : (uint8_t)(__builtin_clzll(remaining) + 1);
+
+    return set_register(hll, index, value);
+}
+
+bool strukts_hyperloglog_add_many(StruktsHyperLogLog* hll, const char* const keys[], size_t n)
+{
+    /* a few KB of registers stay in the L1 cache: adding keys is bound by hashing them */
+    for (size_t i = 0; i < n; i++)
+        if (!strukts_hyperloglog_add_hash(hll, hash_key(keys[i], strlen(keys[i]))))
+            return false;
+
+    return true;
+}
+
+uint64_t strukts_hyperloglog_count(const StruktsHyperLogLog* hll)
+{
+    const double m = (double)hll->registers_amount;
+    size_t zeros = 0;
+    double sum = 0;
+
+    if (hll->sparse) {
+        zeros = hll->registers_amount - hll->sparse_amount;
+        sum = (double)zeros;
+
+        for (size_t i = 0; i < hll->sparse_amount; i++)
+            sum += ldexp(1, -SPARSE_VALUE(hll->sparse_registers[i]));
+    } else {
+        for (size_t i = 0; i < hll->registers_amount; i++) {
+            zeros += hll->registers[i] == 0;
+            sum += ldexp(1, -hll->registers[i]);
+        }
+    }
+
+    double estimate = alpha(hll->registers_amount) * m * m / sum;
+
+    /* small range correction: linear counting while there are empty registers */
+    if (estimate <= 2.5 * m && zeros > 0)
+        estimate = m * log(m / (double)zeros);
+
+    /* 64-bit hashes: no large range correction is needed */
+    return (uint64_t)(estimate + 0.5);
+}
+
+bool strukts_hyperloglog_merge(StruktsHyperLogLog* dest, const StruktsHyperLogLog* src)
+{
+    if (dest->precision != src->precision)
+        return false;
+
+    if (src->sparse) {
+        for (size_t i = 0; i < src->sparse_amount; i++)
+            if (!set_register(dest, SPARSE_INDEX(src->sparse_registers[i]),
+                              SPARSE_VALUE(src->sparse_registers[i])))
+                return false;
+
+        return true;
+    }
+
+    if (dest->sparse && !to_dense(dest))
+        return false;
+
+    for (size_t i = 0; i < dest->registers_amount; i++)
+        if (dest->registers[i] < src->registers[i])
+            dest->registers[i] = src->registers[i];
+
+    return true;
+}
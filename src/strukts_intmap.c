@@ -0,0 +1,215 @@
+#include "strukts_intmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#define calloc sf_calloc
+#endif
+
+/********************** MACROS **********************/
+#define EMPTY_KEY 0
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint64_t mix_key(uint64_t key)
+{
+    /* multiply-xorshift: the multiplication spreads low bits up, the shift brings high bits down */
+    key ^= key >> 32;
+    key *= 0xd6e8feb86659fd93ull;
+    key ^= key >> 32;
+
+    return key;
+}
+
+static inline size_t home_slot(const StruktsIntmap* intmap, uint64_t key)
+{
+    return (size_t)mix_key(key) & (intmap->capacity - 1);
+}
+
+static inline size_t next_slot(const StruktsIntmap* intmap, size_t i)
+{
+    return (i + 1) & (intmap->capacity - 1);
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static StruktsIntmapSlot* intmap_find(const StruktsIntmap* intmap, uint64_t key)
+{
+    /* the load factor is always below 1: an empty slot ends the probe sequence of missing keys */
+    for (size_t i = home_slot(intmap, key); intmap->slots[i].key != EMPTY_KEY;
+         i = next_slot(intmap, i)) {
+        if (intmap->slots[i].key == key)
+            return &intmap->slots[i];
+    }
+
+    return NULL;
+}
+
+static void intmap_insert_new(StruktsIntmap* intmap, uint64_t key, char* value)
+{
+    size_t i = home_slot(intmap, key);
+
+    while (intmap->slots[i].key != EMPTY_KEY)
+        i = next_slot(intmap, i);
+
+    intmap->slots[i].key = key;
+    intmap->slots[i].value = value;
+    intmap->size++;
+}
+
+static bool intmap_resize(StruktsIntmap* intmap, size_t new_capacity)
+{
+    const size_t old_capacity = intmap->capacity;
+    StruktsIntmapSlot* old_slots = intmap->slots;
+    StruktsIntmapSlot* slots = (StruktsIntmapSlot*)calloc(new_capacity, sizeof(StruktsIntmapSlot));
+
+    /* on failure, the map keeps its current slots untouched */
+    if (slots == NULL)
+        return false;
+
+    intmap->slots = slots;
+    intmap->capacity = new_capacity;
+    intmap->size = intmap->has_zero_key ? 1 : 0;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key != EMPTY_KEY)
+            intmap_insert_new(intmap, old_slots[i].key, old_slots[i].value);
+    }
+
+    free(old_slots);
+
+    return true;
+}
+
+static bool is_resizing_needed(const StruktsIntmap* intmap)
+{
+    /* load factor after the new key is added */
+    return (double)(intmap->size + 1) / (double)intmap->capacity > STRUKTS_INTMAP_MAX_LOAD_FACTOR;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsIntmap* strukts_intmap_new()
+{
+    StruktsIntmap* intmap = (StruktsIntmap*)malloc(sizeof(StruktsIntmap));
+
+    if (intmap == NULL)
+        return NULL;
+
+    /* calloc: every slot starts empty (key 0) */
+    intmap->size = 0;
+    intmap->capacity = STRUKTS_INTMAP_INITIAL_CAPACITY;
+    intmap->has_zero_key = false;
+    intmap->zero_value = NULL;
+    intmap->slots = (StruktsIntmapSlot*)calloc(intmap->capacity, sizeof(StruktsIntmapSlot));
+
+    if (intmap->slots == NULL) {
+        free(intmap);
+
+        return NULL;
+    }
+
+    return intmap;
+}
+
+void strukts_intmap_free(StruktsIntmap* intmap)
+{
+    if (intmap == NULL)
+        return;
+
+    free(intmap->slots);
+    free(intmap);
+}
+
+bool strukts_intmap_upsert(StruktsIntmap* intmap, uint64_t key, char* value)
+{
+    if (key == EMPTY_KEY) {
+        intmap->size += intmap->has_zero_key ? 0 : 1;
+        intmap->has_zero_key = true;
+        intmap->zero_value = value;
+
+        return true;
+    }
+
+    StruktsIntmapSlot* slot = intmap_find(intmap, key);
+
+    /* existing keys just have their values replaced */
+    if (slot != NULL) {
+        slot->value = value;
+
+        return true;
+    }
+
+    if (is_resizing_needed(intmap) && !intmap_resize(intmap, 2 * intmap->capacity))
+        return false;
+
+    intmap_insert_new(intmap, key, value);
+
+    return true;
+}
+
+bool strukts_intmap_remove(StruktsIntmap* intmap, uint64_t key)
+{
+    if (key == EMPTY_KEY) {
+        if (!intmap->has_zero_key)
+            return false;
+
+        intmap->has_zero_key = false;
+        intmap->zero_value = NULL;
+        intmap->size--;
+
+        return true;
+    }
+
+    StruktsIntmapSlot* slot = intmap_find(intmap, key);
+
+    if (slot == NULL)
+        return false;
+
+    size_t hole = (size_t)(slot - intmap->slots);
+
+    /*
+     * Backward shift: a following key moves into the hole unless its home slot lies cyclically
+     * in (hole, i], in which case moving it would place it before its home slot.
+     */
+    for (size_t i = next_slot(intmap, hole); intmap->slots[i].key != EMPTY_KEY;
+         i = next_slot(intmap, i)) {
+        size_t home = home_slot(intmap, intmap->slots[i].key);
+        size_t distance_to_home = (i - home) & (intmap->capacity - 1);
+        size_t distance_to_hole = (i - hole) & (intmap->capacity - 1);
+
+        if (distance_to_home >= distance_to_hole) {
+            intmap->slots[hole] = intmap->slots[i];
+            hole = i;
+        }
+    }
+
+    intmap->slots[hole].key = EMPTY_KEY;
+    intmap->slots[hole].value = NULL;
+    intmap->size--;
+
+    return true;
+}
+
+char* strukts_intmap_get(const StruktsIntmap* intmap, uint64_t key)
+{
+    if (key == EMPTY_KEY)
+        return intmap->zero_value;
+
+    StruktsIntmapSlot* slot = intmap_find(intmap, key);
+
+    if (slot == NULL)
+        return NULL;
+
+    return slot->value;
+}
+
+bool strukts_intmap_contains(const StruktsIntmap* intmap, uint64_t key)
+{
+    if (key == EMPTY_KEY)
+        return intmap->has_zero_key;
+
+    return intmap_find(intmap, key) != NULL;
+}
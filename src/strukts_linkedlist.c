@@ -165,6 +165,43 @@ bool strukts_linkedlist_remove(StruktsLinkedList* list, const char* key)
     return true;
 }
 
+static void strukts_linkedlistnode_unlink(StruktsLinkedList* list, StruktsLinkedListNode* node)
+{
+    if (node->previous != NULL)
+        node->previous->next = node->next;
+    else
+        list->first_node = node->next;
+
+    if (node->next != NULL)
+        node->next->previous = node->previous;
+    else
+        list->last_node = node->previous;
+
+    node->next = NULL;
+    node->previous = NULL;
+}
+
+void strukts_linkedlist_remove_node(StruktsLinkedList* list, StruktsLinkedListNode* node)
+{
+    strukts_linkedlistnode_unlink(list, node);
+    list->size--;
+
+    free(node);
+}
+
+void strukts_linkedlist_move_to_front(StruktsLinkedList* list, StruktsLinkedListNode* node)
+{
+    if (list->first_node == node)
+        return;
+
+    strukts_linkedlistnode_unlink(list, node);
+
+    /* the list still has at least one node: the old first one */
+    node->next = list->first_node;
+    list->first_node->previous = node;
+    list->first_node = node;
+}
+
 StruktsLinearSearchResult strukts_linkedlist_find(StruktsLinkedList* list, const char* key)
 {
     StruktsLinkedListNode* current_node = list->first_node;
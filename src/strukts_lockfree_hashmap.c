@@ -0,0 +1,313 @@
+#include "strukts_lockfree_hashmap.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_epoch.h"
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#define calloc sf_calloc
+#endif
+
+/********************** MACROS **********************/
+#define LOAD(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+#define PUBLISH(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint32_t hash_key(const char* key, size_t key_len)
+{
+    return strukts_murmur3_hash((const uint8_t*)key, key_len, 0);
+}
+
+static inline bool node_has_key(const StruktsLockFreeHashmapNode* node, const char* key,
+                                size_t key_len, uint32_t hash)
+{
+    return node->hash == hash && node->key_len == key_len && memcmp(node->key, key, key_len) == 0;
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static StruktsLockFreeHashmapNode* node_new(const char* key, size_t key_len, uint32_t hash,
+                                            char* value, StruktsLockFreeHashmapNode* next)
+{
+    StruktsLockFreeHashmapNode* node =
+        (StruktsLockFreeHashmapNode*)malloc(sizeof(StruktsLockFreeHashmapNode) + key_len + 1);
+
+    if (node == NULL)
+        return NULL;
+
+    memcpy(node->key, key, key_len);
+    node->key[key_len] = '\0';
+    node->key_len = key_len;
+    node->hash = hash;
+    node->value = value;
+    node->next = next; /* not visible to readers until the node itself is published */
+
+    return node;
+}
+
+static void node_free(void* node)
+{
+    free(node);
+}
+
+static StruktsLockFreeHashmapTable* table_new(size_t capacity)
+{
+    StruktsLockFreeHashmapTable* table =
+        (StruktsLockFreeHashmapTable*)malloc(sizeof(StruktsLockFreeHashmapTable));
+
+    if (table == NULL)
+        return NULL;
+
+    table->buckets =
+        (StruktsLockFreeHashmapNode**)calloc(capacity, sizeof(StruktsLockFreeHashmapNode*));
+
+    if (table->buckets == NULL) {
+        free(table);
+
+        return NULL;
+    }
+
+    table->capacity = capacity;
+
+    return table;
+}
+
+/* deallocates a table and every node still linked in it (used for retired tables) */
+static void table_free(void* object)
+{
+    StruktsLockFreeHashmapTable* table = (StruktsLockFreeHashmapTable*)object;
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        StruktsLockFreeHashmapNode* node = table->buckets[i];
+
+        while (node != NULL) {
+            StruktsLockFreeHashmapNode* next_node = node->next;
+
+            free(node);
+            node = next_node;
+        }
+    }
+
+    free(table->buckets);
+    free(table);
+}
+
+/* searches a key's link (bucket head or previous node's next) in the current table: writers only */
+static StruktsLockFreeHashmapNode** chain_find(StruktsLockFreeHashmapTable* table, const char* key,
+                                               size_t key_len, uint32_t hash)
+{
+    StruktsLockFreeHashmapNode** link = &table->buckets[hash & (table->capacity - 1)];
+
+    while (*link != NULL) {
+        if (node_has_key(*link, key, key_len, hash))
+            return link;
+
+        link = &(*link)->next;
+    }
+
+    return link; /* link that holds NULL: the chain's tail */
+}
+
+/*
+ * Builds a doubled copy of the current table with copies of its nodes and publishes it with a
+ * single release store: readers either keep walking the old (frozen) table or see the complete new
+ * one. The old table and its nodes are retired. On failures, the hash map keeps its current table.
+ */
+static void resize(StruktsLockFreeHashmap* hashmap)
+{
+    StruktsLockFreeHashmapTable* old_table = hashmap->table;
+    StruktsLockFreeHashmapTable* new_table = table_new(old_table->capacity * 2);
+
+    if (new_table == NULL)
+        return;
+
+    for (size_t i = 0; i < old_table->capacity; i++) {
+        for (StruktsLockFreeHashmapNode* node = old_table->buckets[i]; node != NULL;
+             node = node->next) {
+            StruktsLockFreeHashmapNode** bucket =
+                &new_table->buckets[node->hash & (new_table->capacity - 1)];
+            StruktsLockFreeHashmapNode* copy =
+                node_new(node->key, node->key_len, node->hash, node->value, *bucket);
+
+            if (copy == NULL) {
+                table_free(new_table);
+
+                return;
+            }
+
+            *bucket = copy;
+        }
+    }
+
+    if (!strukts_epoch_retire(hashmap->epoch, old_table, table_free)) {
+        table_free(new_table);
+
+        return;
+    }
+
+    PUBLISH(&hashmap->table, new_table);
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsLockFreeHashmap* strukts_lockfree_hashmap_new(size_t max_readers)
+{
+    StruktsLockFreeHashmap* hashmap =
+        (StruktsLockFreeHashmap*)malloc(sizeof(StruktsLockFreeHashmap));
+
+    if (hashmap == NULL)
+        return NULL;
+
+    hashmap->size = 0;
+    hashmap->table = table_new(STRUKTS_LOCKFREE_HASHMAP_INITIAL_CAPACITY);
+    hashmap->epoch = strukts_epoch_domain_new(max_readers);
+
+    if (hashmap->table == NULL || hashmap->epoch == NULL ||
+        pthread_mutex_init(&hashmap->writer_lock, NULL) != 0) {
+        if (hashmap->table != NULL)
+            table_free(hashmap->table);
+
+        strukts_epoch_domain_free(hashmap->epoch);
+        free(hashmap);
+
+        return NULL;
+    }
+
+    return hashmap;
+}
+
+void strukts_lockfree_hashmap_free(StruktsLockFreeHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    table_free(hashmap->table);
+    strukts_epoch_domain_free(hashmap->epoch); /* deallocates every retired node and table */
+    pthread_mutex_destroy(&hashmap->writer_lock);
+    free(hashmap);
+}
+
+StruktsEpochReader* strukts_lockfree_hashmap_reader_register(StruktsLockFreeHashmap* hashmap)
+{
+    pthread_mutex_lock(&hashmap->writer_lock);
+    StruktsEpochReader* reader = strukts_epoch_reader_register(hashmap->epoch);
+    pthread_mutex_unlock(&hashmap->writer_lock);
+
+    return reader;
+}
+
+void strukts_lockfree_hashmap_reader_unregister(StruktsLockFreeHashmap* hashmap,
+                                                StruktsEpochReader* reader)
+{
+    pthread_mutex_lock(&hashmap->writer_lock);
+    strukts_epoch_reader_unregister(hashmap->epoch, reader);
+    pthread_mutex_unlock(&hashmap->writer_lock);
+}
+
+bool strukts_lockfree_hashmap_upsert(StruktsLockFreeHashmap* hashmap, const char* key, char* value)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = hash_key(key, key_len);
+    bool upserted = false;
+
+    pthread_mutex_lock(&hashmap->writer_lock);
+
+    StruktsLockFreeHashmapNode** link = chain_find(hashmap->table, key, key_len, hash);
+    StruktsLockFreeHashmapNode* old_node = *link;
+
+    if (old_node != NULL) {
+        /* published nodes are immutable: the replacement takes the old node's place in the chain */
+        StruktsLockFreeHashmapNode* node = node_new(key, key_len, hash, value, old_node->next);
+
+        if (node != NULL && strukts_epoch_retire(hashmap->epoch, old_node, node_free)) {
+            PUBLISH(link, node);
+            upserted = true;
+        } else {
+            free(node);
+        }
+    } else {
+        StruktsLockFreeHashmapNode** bucket =
+            &hashmap->table->buckets[hash & (hashmap->table->capacity - 1)];
+        StruktsLockFreeHashmapNode* node = node_new(key, key_len, hash, value, *bucket);
+
+        if (node != NULL) {
+            PUBLISH(bucket, node);
+            hashmap->size++;
+            upserted = true;
+
+            if ((double)hashmap->size / hashmap->table->capacity >=
+                STRUKTS_LOCKFREE_HASHMAP_MAX_LOAD_FACTOR)
+                resize(hashmap);
+        }
+    }
+
+    strukts_epoch_try_reclaim(hashmap->epoch);
+    pthread_mutex_unlock(&hashmap->writer_lock);
+
+    return upserted;
+}
+
+bool strukts_lockfree_hashmap_remove(StruktsLockFreeHashmap* hashmap, const char* key)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = hash_key(key, key_len);
+    bool removed = false;
+
+    pthread_mutex_lock(&hashmap->writer_lock);
+
+    StruktsLockFreeHashmapNode** link = chain_find(hashmap->table, key, key_len, hash);
+    StruktsLockFreeHashmapNode* node = *link;
+
+    /* the unlinked node keeps its next pointer, so readers standing on it can finish their walk */
+    if (node != NULL && strukts_epoch_retire(hashmap->epoch, node, node_free)) {
+        PUBLISH(link, node->next);
+        hashmap->size--;
+        removed = true;
+    }
+
+    strukts_epoch_try_reclaim(hashmap->epoch);
+    pthread_mutex_unlock(&hashmap->writer_lock);
+
+    return removed;
+}
+
+char* strukts_lockfree_hashmap_get(StruktsLockFreeHashmap* hashmap, StruktsEpochReader* reader,
+                                   const char* key)
+{
+    size_t key_len = strlen(key);
+    uint32_t hash = hash_key(key, key_len);
+    char* value = NULL;
+
+    strukts_epoch_enter(hashmap->epoch, reader);
+
+    StruktsLockFreeHashmapTable* table = LOAD(&hashmap->table);
+    StruktsLockFreeHashmapNode* node = LOAD(&table->buckets[hash & (table->capacity - 1)]);
+
+    while (node != NULL) {
+        if (node_has_key(node, key, key_len, hash)) {
+            value = node->value;
+            break;
+        }
+
+        node = LOAD(&node->next);
+    }
+
+    strukts_epoch_exit(reader);
+
+    return value;
+}
+
+size_t strukts_lockfree_hashmap_size(StruktsLockFreeHashmap* hashmap)
+{
+    pthread_mutex_lock(&hashmap->writer_lock);
+    size_t size = hashmap->size;
+    pthread_mutex_unlock(&hashmap->writer_lock);
+
+    return size;
+}
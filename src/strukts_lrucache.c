@@ -0,0 +1,159 @@
+#include "strukts_lrucache.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashmap.h"
+#include "strukts_linkedlist.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#endif
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline size_t entry_bytes(const char* key, const char* value)
+{
+    return strlen(key) + (value != NULL ? strlen(value) : 0);
+}
+
+static inline bool is_over_limits(const StruktsLRUCache* cache)
+{
+    return (cache->max_entries != 0 && cache->recency->size > cache->max_entries) ||
+           (cache->max_bytes != 0 && cache->bytes > cache->max_bytes);
+}
+
+static inline StruktsLinkedListNode* node_of(StruktsLRUCache* cache, const char* key)
+{
+    /* the index's values are the list nodes of the keys */
+    return (StruktsLinkedListNode*)strukts_hashmap_get(cache->index, key);
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static void remove_node(StruktsLRUCache* cache, StruktsLinkedListNode* node)
+{
+    cache->bytes -= entry_bytes(node->key, node->value);
+    strukts_hashmap_remove(cache->index, node->key);
+    strukts_linkedlist_remove_node(cache->recency, node);
+}
+
+/* evicts least recently used entries: the first node (the latest put) is never evicted */
+static void evict(StruktsLRUCache* cache)
+{
+    while (is_over_limits(cache) && cache->recency->last_node != cache->recency->first_node) {
+        remove_node(cache, cache->recency->last_node);
+        cache->evictions++;
+    }
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsLRUCache* strukts_lrucache_new(size_t max_entries, size_t max_bytes)
+{
+    if (max_entries == 0 && max_bytes == 0)
+        return NULL; /* unbounded caches are just hash maps */
+
+    StruktsLRUCache* cache = (StruktsLRUCache*)malloc(sizeof(StruktsLRUCache));
+
+    if (cache == NULL)
+        return NULL;
+
+    cache->max_entries = max_entries;
+    cache->max_bytes = max_bytes;
+    cache->bytes = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    cache->index = strukts_hashmap_new();
+    cache->recency = strukts_linkedlist_new();
+
+    if (cache->index == NULL || cache->recency == NULL) {
+        strukts_lrucache_free(cache);
+
+        return NULL;
+    }
+
+    return cache;
+}
+
+void strukts_lrucache_free(StruktsLRUCache* cache)
+{
+    if (cache == NULL)
+        return;
+
+    if (cache->index != NULL)
+        strukts_hashmap_free(cache->index);
+
+    if (cache->recency != NULL)
+        strukts_linkedlist_free(cache->recency);
+
+    free(cache);
+}
+
+bool strukts_lrucache_put(StruktsLRUCache* cache, const char* key, char* value)
+{
+    size_t bytes = entry_bytes(key, value);
+
+    if (cache->max_bytes != 0 && bytes > cache->max_bytes)
+        return false; /* it'd evict the whole cache and still not fit */
+
+    StruktsLinkedListNode* node = node_of(cache, key);
+
+    if (node != NULL) {
+        cache->bytes = cache->bytes - entry_bytes(node->key, node->value) + bytes;
+        node->value = value;
+        strukts_linkedlist_move_to_front(cache->recency, node);
+    } else {
+        if (!strukts_linkedlist_prepend(cache->recency, key, value))
+            return false;
+
+        node = cache->recency->first_node;
+
+        if (!strukts_hashmap_upsert(cache->index, key, (char*)node)) {
+            strukts_linkedlist_remove_first(cache->recency);
+
+            return false;
+        }
+
+        cache->bytes += bytes;
+    }
+
+    evict(cache);
+
+    return true;
+}
+
+char* strukts_lrucache_get(StruktsLRUCache* cache, const char* key)
+{
+    StruktsLinkedListNode* node = node_of(cache, key);
+
+    if (node == NULL) {
+        cache->misses++;
+
+        return NULL;
+    }
+
+    cache->hits++;
+    strukts_linkedlist_move_to_front(cache->recency, node);
+
+    return node->value;
+}
+
+bool strukts_lrucache_remove(StruktsLRUCache* cache, const char* key)
+{
+    StruktsLinkedListNode* node = node_of(cache, key);
+
+    if (node == NULL)
+        return false;
+
+    remove_node(cache, node);
+
+    return true;
+}
+
+size_t strukts_lrucache_size(const StruktsLRUCache* cache)
+{
+    return cache->recency->size;
+}
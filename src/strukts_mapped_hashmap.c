@@ -0,0 +1,330 @@
+#include "strukts_mapped_hashmap.h"
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "strukts_hashing.h"
+#include "strukts_hashmap.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define calloc sf_calloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define TMP_SUFFIX ".tmp"
+
+/********************** PRIVATE STRUCTS **********************/
+typedef struct _StruktsMappedHashmapWriter StruktsMappedHashmapWriter;
+
+/* slot array being built in memory: entries[i] is the hash map entry saved into slots[i] */
+struct _StruktsMappedHashmapWriter {
+    size_t slots_amount;
+    StruktsMappedHashmapSlot* slots;
+    const StruktsHashmapEntry** entries;
+};
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline size_t home_slot(uint32_t hash, size_t slots_amount)
+{
+    /* maps the hash to [0, slots_amount) with a multiplication: any amount of slots works */
+    return (size_t)(((uint64_t)hash * (uint64_t)slots_amount) >> 32);
+}
+
+static inline uint32_t hash_key(const StruktsMappedHashmap* hashmap, const void* key,
+                                size_t key_len)
+{
+    /* slots keep the hashes of the saved hash map: the key must be hashed the same way */
+    if (hashmap->hash_flags & STRUKTS_HASHMAP_MURMUR3_128) {
+        uint64_t hash[2];
+
+        strukts_murmur3_hash_x64_128((const uint8_t*)key, key_len, 0, hash);
+
+        return (uint32_t)hash[0];
+    }
+
+    return strukts_murmur3_hash((const uint8_t*)key, key_len, 0);
+}
+
+static inline size_t next_slot(size_t i, size_t slots_amount)
+{
+    return i + 1 == slots_amount ? 0 : i + 1;
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static void writer_add_chain(StruktsMappedHashmapWriter* writer, const StruktsHashmapEntry* entry)
+{
+    for (; entry != NULL; entry = entry->next) {
+        size_t i = home_slot(entry->hash, writer->slots_amount);
+        bool shadowed = false;
+
+        /* entries are added newest first: an older entry of the same key is skipped */
+        for (; writer->entries[i] != NULL && !shadowed; i = next_slot(i, writer->slots_amount)) {
+            const StruktsHashmapEntry* saved = writer->entries[i];
+
+            shadowed = saved->hash == entry->hash && saved->key_len == entry->key_len &&
+                       memcmp(saved->key, entry->key, entry->key_len) == 0;
+        }
+
+        if (!shadowed)
+            writer->entries[i] = entry;
+    }
+}
+
+static bool writer_layout(StruktsMappedHashmapWriter* writer, StruktsMappedHashmapHeader* header)
+{
+    uint64_t offset = header->blob_offset;
+
+    /* keys/values are laid out in slot order, right after each other */
+    for (size_t i = 0; i < writer->slots_amount; i++) {
+        const StruktsHashmapEntry* entry = writer->entries[i];
+
+        if (entry == NULL)
+            continue;
+
+        if (entry->key_len > UINT32_MAX)
+            return false; /* key lengths are saved as 32-bit integers */
+
+        writer->slots[i].hash = entry->hash;
+        writer->slots[i].key_len = (uint32_t)entry->key_len;
+        writer->slots[i].key_offset = offset;
+        offset += entry->key_len + 1;
+
+        if (entry->value != NULL) {
+            writer->slots[i].value_offset = offset;
+            offset += strlen(entry->value) + 1;
+        }
+
+        header->size++;
+    }
+
+    header->blob_bytes = offset - header->blob_offset;
+
+    return true;
+}
+
+static bool write_blob(const StruktsMappedHashmapWriter* writer, FILE* file)
+{
+    for (size_t i = 0; i < writer->slots_amount; i++) {
+        const StruktsHashmapEntry* entry = writer->entries[i];
+
+        if (entry == NULL)
+            continue;
+
+        if (fwrite(entry->key, 1, entry->key_len, file) != entry->key_len)
+            return false;
+
+        if (fputc('\0', file) == EOF)
+            return false;
+
+        /* NULL values are saved as a 0 offset: nothing is written */
+        if (entry->value == NULL)
+            continue;
+
+        const size_t value_bytes = strlen(entry->value) + 1; /* with its NUL terminator */
+
+        if (fwrite(entry->value, 1, value_bytes, file) != value_bytes)
+            return false;
+    }
+
+    return true;
+}
+
+static bool write_file(const StruktsMappedHashmapWriter* writer, StruktsMappedHashmapHeader* header,
+                       const char* path)
+{
+    FILE* file = fopen(path, "wb");
+
+    if (file == NULL)
+        return false;
+
+    bool written =
+        fwrite(header, sizeof(StruktsMappedHashmapHeader), 1, file) == 1 &&
+        fwrite(writer->slots, sizeof(StruktsMappedHashmapSlot), writer->slots_amount, file) ==
+            writer->slots_amount &&
+        write_blob(writer, file);
+
+    /* buffered bytes may still fail to be written when the file is closed */
+    return fclose(file) == 0 && written;
+}
+
+static bool is_valid_file(const char* file, size_t file_bytes)
+{
+    const StruktsMappedHashmapHeader* header = (const StruktsMappedHashmapHeader*)file;
+    const uint64_t slots_bytes = header->slots_amount * sizeof(StruktsMappedHashmapSlot);
+
+    /* a NUL as the last byte guarantees that reading any key or value ends inside the file */
+    if (file_bytes > sizeof(StruktsMappedHashmapHeader) && file[file_bytes - 1] != '\0')
+        return false;
+
+    return memcmp(header->magic, STRUKTS_MAPPED_HASHMAP_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == STRUKTS_MAPPED_HASHMAP_VERSION &&
+           header->byte_order == STRUKTS_MAPPED_HASHMAP_BYTE_ORDER && header->slots_amount > 0 &&
+           header->slots_amount <= UINT32_MAX && header->size < header->slots_amount &&
+           header->slots_offset == sizeof(StruktsMappedHashmapHeader) &&
+           header->blob_offset == header->slots_offset + slots_bytes &&
+           header->blob_offset <= file_bytes &&
+           header->blob_bytes == file_bytes - header->blob_offset &&
+           (header->hash_flags & ~(uint64_t)STRUKTS_HASHMAP_MURMUR3_128) == 0;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+bool strukts_mapped_hashmap_write(const StruktsHashmap* hashmap, const char* path)
+{
+    StruktsMappedHashmapWriter writer;
+
+    /* at least one slot is always empty: it ends the probe sequences of missing keys */
+    writer.slots_amount =
+        (size_t)((double)hashmap->size / STRUKTS_MAPPED_HASHMAP_MAX_LOAD_FACTOR) + 1;
+
+    if (writer.slots_amount > UINT32_MAX)
+        return false; /* slots are addressed by 32-bit hashes */
+
+    writer.slots =
+        (StruktsMappedHashmapSlot*)calloc(writer.slots_amount, sizeof(StruktsMappedHashmapSlot));
+    writer.entries =
+        (const StruktsHashmapEntry**)calloc(writer.slots_amount, sizeof(StruktsHashmapEntry*));
+    char* tmp_path = (char*)malloc(strlen(path) + sizeof(TMP_SUFFIX));
+    bool written = false;
+
+    if (writer.slots != NULL && writer.entries != NULL && tmp_path != NULL) {
+        /* newest keys first: the newest bucket array, then the not yet migrated old buckets */
+        for (size_t i = 0; i < hashmap->capacity; i++)
+            writer_add_chain(&writer, hashmap->buckets[i]);
+
+        if (hashmap->old_buckets != NULL) {
+            for (size_t i = hashmap->rehash_index; i < hashmap->old_capacity; i++)
+                writer_add_chain(&writer, hashmap->old_buckets[i]);
+        }
+
+        StruktsMappedHashmapHeader header;
+        const uint64_t slots_bytes = writer.slots_amount * sizeof(StruktsMappedHashmapSlot);
+
+        memset(&header, 0, sizeof(StruktsMappedHashmapHeader));
+        memcpy(header.magic, STRUKTS_MAPPED_HASHMAP_MAGIC, sizeof(header.magic));
+        header.version = STRUKTS_MAPPED_HASHMAP_VERSION;
+        header.byte_order = STRUKTS_MAPPED_HASHMAP_BYTE_ORDER;
+        header.slots_amount = writer.slots_amount;
+        header.slots_offset = sizeof(StruktsMappedHashmapHeader);
+        header.blob_offset = header.slots_offset + slots_bytes;
+        header.hash_flags = hashmap->flags & STRUKTS_HASHMAP_MURMUR3_128;
+
+        /* the new file replaces the previous one at once: mapped previous files stay valid */
+        strcpy(tmp_path, path);
+        strcat(tmp_path, TMP_SUFFIX);
+
+        if (writer_layout(&writer, &header)) {
+            written = write_file(&writer, &header, tmp_path) && rename(tmp_path, path) == 0;
+
+            if (!written)
+                remove(tmp_path);
+        }
+    }
+
+    free(writer.slots);
+    free(writer.entries);
+    free(tmp_path);
+
+    return written;
+}
+
+StruktsMappedHashmap* strukts_mapped_hashmap_open(const char* path)
+{
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return NULL;
+
+    struct stat file_stat;
+
+    if (fstat(fd, &file_stat) != 0 ||
+        (size_t)file_stat.st_size < sizeof(StruktsMappedHashmapHeader)) {
+        close(fd);
+
+        return NULL;
+    }
+
+    /* shared read-only mapping: the pages are shared with every process that maps the file */
+    const size_t file_bytes = (size_t)file_stat.st_size;
+    void* file = mmap(NULL, file_bytes, PROT_READ, MAP_SHARED, fd, 0);
+
+    close(fd); /* the mapping keeps the file alive */
+
+    if (file == MAP_FAILED)
+        return NULL;
+
+    const StruktsMappedHashmapHeader* header = (const StruktsMappedHashmapHeader*)file;
+    StruktsMappedHashmap* hashmap = NULL;
+
+    if (is_valid_file((const char*)file, file_bytes))
+        hashmap = (StruktsMappedHashmap*)malloc(sizeof(StruktsMappedHashmap));
+
+    if (hashmap == NULL) {
+        munmap(file, file_bytes);
+
+        return NULL;
+    }
+
+    /* lookups hit random slots: read-ahead would only load pages that are not needed */
+    madvise(file, file_bytes, MADV_RANDOM);
+
+    hashmap->size = header->size;
+    hashmap->slots_amount = header->slots_amount;
+    hashmap->slots = (const StruktsMappedHashmapSlot*)((const char*)file + header->slots_offset);
+    hashmap->file = (const char*)file;
+    hashmap->file_bytes = file_bytes;
+    hashmap->hash_flags = (unsigned int)header->hash_flags;
+
+    return hashmap;
+}
+
+void strukts_mapped_hashmap_close(StruktsMappedHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    munmap((void*)hashmap->file, hashmap->file_bytes);
+    free(hashmap);
+}
+
+const char* strukts_mapped_hashmap_get(const StruktsMappedHashmap* hashmap, const char* key)
+{
+    return strukts_mapped_hashmap_get_n(hashmap, key, strlen(key));
+}
+
+const char* strukts_mapped_hashmap_get_n(const StruktsMappedHashmap* hashmap, const void* key,
+                                         size_t key_len)
+{
+    const uint32_t hash = hash_key(hashmap, key, key_len);
+    size_t i = home_slot(hash, hashmap->slots_amount);
+
+    /* probes are bounded as well: a corrupted file could have no empty slots */
+    for (size_t probes = 0; probes < hashmap->slots_amount && hashmap->slots[i].key_offset != 0;
+         probes++, i = next_slot(i, hashmap->slots_amount)) {
+        const StruktsMappedHashmapSlot* slot = &hashmap->slots[i];
+
+        if (slot->hash != hash || slot->key_len != key_len)
+            continue;
+
+        /* offsets are checked against the file's size: corrupted files are never read past it
+         * (without adding to offsets, which could wrap around) */
+        if (slot->key_offset >= hashmap->file_bytes ||
+            key_len >= hashmap->file_bytes - slot->key_offset ||
+            slot->value_offset >= hashmap->file_bytes)
+            return NULL;
+
+        if (memcmp(hashmap->file + slot->key_offset, key, key_len) == 0)
+            return slot->value_offset != 0 ? hashmap->file + slot->value_offset : NULL;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,256 @@
+#include "strukts_perfect_hash.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define calloc sf_calloc
+#define free sf_free
+#endif
+
+/********************** MACROS **********************/
+#define WORD_BITS 64
+#define BLOCK_BITS (STRUKTS_PERFECT_HASH_RANK_WORDS * WORD_BITS)
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint32_t level_seed(size_t level)
+{
+    /* golden ratio increments: every level hashes the keys with a different seed */
+    return (uint32_t)(level + 1) * 0x9e3779b9u;
+}
+
+static inline size_t level_position(const void* key, size_t key_len, size_t level,
+                                    size_t level_bits)
+{
+    uint32_t hash = strukts_murmur3_hash((const uint8_t*)key, key_len, level_seed(level));
+
+    /* maps the hash to [0, level_bits) with a multiplication instead of a division */
+    return (size_t)(((uint64_t)hash * (uint64_t)level_bits) >> 32);
+}
+
+static inline bool is_bit_set(const uint64_t* words, size_t bit)
+{
+    return (words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1;
+}
+
+static inline void set_bit(uint64_t* words, size_t bit)
+{
+    words[bit / WORD_BITS] |= 1ull << (bit % WORD_BITS);
+}
+
+static inline void clear_bit(uint64_t* words, size_t bit)
+{
+    words[bit / WORD_BITS] &= ~(1ull << (bit % WORD_BITS));
+}
+
+static inline size_t rank(const StruktsPerfectHash* perfect_hash, size_t bit)
+{
+    const size_t word = bit / WORD_BITS;
+    size_t set_bits = perfect_hash->ranks[bit / BLOCK_BITS];
+
+    /* the directory gives the set bits before the block: at most 7 words are counted here */
+    for (size_t w = (bit / BLOCK_BITS) * STRUKTS_PERFECT_HASH_RANK_WORDS; w < word; w++)
+        set_bits += (size_t)__builtin_popcountll(perfect_hash->bits[w]);
+
+    return set_bits + (size_t)__builtin_popcountll(perfect_hash->bits[word] &
+                                                   ((1ull << (bit % WORD_BITS)) - 1));
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static size_t build_level(const char* const keys[], const size_t* key_lens, size_t* remaining,
+                          size_t remaining_amount, size_t level, uint64_t* level_words,
+                          uint64_t* collisions, size_t level_bits)
+{
+    /* pass 1: keys alone in their bits set them, bits hit by two or more keys are collisions */
+    for (size_t i = 0; i < remaining_amount; i++) {
+        const size_t k = remaining[i];
+        const size_t bit = level_position(keys[k], key_lens[k], level, level_bits);
+
+        if (is_bit_set(collisions, bit))
+            continue;
+
+        if (is_bit_set(level_words, bit)) {
+            clear_bit(level_words, bit);
+            set_bit(collisions, bit);
+        } else {
+            set_bit(level_words, bit);
+        }
+    }
+
+    /* pass 2: colliding keys are kept (compacted in place) for the next level */
+    size_t next_amount = 0;
+
+    for (size_t i = 0; i < remaining_amount; i++) {
+        const size_t k = remaining[i];
+
+        if (!is_bit_set(level_words, level_position(keys[k], key_lens[k], level, level_bits)))
+            remaining[next_amount++] = k;
+    }
+
+    return next_amount;
+}
+
+static bool build_ranks(StruktsPerfectHash* perfect_hash)
+{
+    const size_t blocks =
+        (perfect_hash->words_amount + STRUKTS_PERFECT_HASH_RANK_WORDS - 1) /
+        STRUKTS_PERFECT_HASH_RANK_WORDS;
+    size_t set_bits = 0;
+
+    perfect_hash->ranks = (uint64_t*)malloc((blocks > 0 ? blocks : 1) * sizeof(uint64_t));
+
+    if (perfect_hash->ranks == NULL)
+        return false;
+
+    for (size_t w = 0; w < perfect_hash->words_amount; w++) {
+        if (w % STRUKTS_PERFECT_HASH_RANK_WORDS == 0)
+            perfect_hash->ranks[w / STRUKTS_PERFECT_HASH_RANK_WORDS] = set_bits;
+
+        set_bits += (size_t)__builtin_popcountll(perfect_hash->bits[w]);
+    }
+
+    return true;
+}
+
+static bool build_levels(StruktsPerfectHash* perfect_hash, const char* const keys[],
+                         const size_t* key_lens, size_t* remaining, uint64_t** levels)
+{
+    size_t remaining_amount = perfect_hash->keys_amount;
+
+    while (remaining_amount > 0) {
+        const size_t level = perfect_hash->levels_amount;
+
+        if (level == STRUKTS_PERFECT_HASH_MAX_LEVELS)
+            return false; /* keys that always collide, such as duplicates */
+
+        const size_t words =
+            (size_t)(STRUKTS_PERFECT_HASH_GAMMA * (double)remaining_amount) / WORD_BITS + 1;
+        const size_t level_bits = words * WORD_BITS;
+
+        if (level_bits > UINT32_MAX)
+            return false; /* bits are addressed by 32-bit hashes */
+
+        uint64_t* collisions = (uint64_t*)calloc(words, sizeof(uint64_t));
+
+        levels[level] = (uint64_t*)calloc(words, sizeof(uint64_t));
+
+        if (levels[level] == NULL || collisions == NULL) {
+            free(collisions);
+
+            return false;
+        }
+
+        perfect_hash->level_bits[level] = level_bits;
+        perfect_hash->level_offset[level] = perfect_hash->words_amount * WORD_BITS;
+        perfect_hash->words_amount += words;
+        perfect_hash->levels_amount++;
+
+        remaining_amount = build_level(keys, key_lens, remaining, remaining_amount, level,
+                                       levels[level], collisions, level_bits);
+        free(collisions);
+    }
+
+    /* all levels are concatenated so that ranks are counted over a single bit array */
+    const size_t words_amount = perfect_hash->words_amount;
+
+    perfect_hash->bits =
+        (uint64_t*)malloc((words_amount > 0 ? words_amount : 1) * sizeof(uint64_t));
+
+    if (perfect_hash->bits == NULL)
+        return false;
+
+    for (size_t level = 0; level < perfect_hash->levels_amount; level++) {
+        memcpy(perfect_hash->bits + perfect_hash->level_offset[level] / WORD_BITS, levels[level],
+               perfect_hash->level_bits[level] / 8);
+    }
+
+    return build_ranks(perfect_hash);
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsPerfectHash* strukts_perfect_hash_build(const char* const keys[], size_t n)
+{
+    StruktsPerfectHash* perfect_hash = (StruktsPerfectHash*)calloc(1, sizeof(StruktsPerfectHash));
+
+    if (perfect_hash == NULL)
+        return NULL;
+
+    perfect_hash->keys_amount = n;
+
+    size_t* key_lens = (size_t*)malloc((n > 0 ? n : 1) * sizeof(size_t));
+    size_t* remaining = (size_t*)malloc((n > 0 ? n : 1) * sizeof(size_t));
+    uint64_t* levels[STRUKTS_PERFECT_HASH_MAX_LEVELS] = {NULL};
+    bool built = false;
+
+    if (key_lens != NULL && remaining != NULL) {
+        for (size_t i = 0; i < n; i++) {
+            key_lens[i] = strlen(keys[i]);
+            remaining[i] = i;
+        }
+
+        built = build_levels(perfect_hash, keys, key_lens, remaining, levels);
+    }
+
+    for (size_t level = 0; level < STRUKTS_PERFECT_HASH_MAX_LEVELS; level++)
+        free(levels[level]);
+
+    free(key_lens);
+    free(remaining);
+
+    if (!built) {
+        strukts_perfect_hash_free(perfect_hash);
+
+        return NULL;
+    }
+
+    return perfect_hash;
+}
+
+void strukts_perfect_hash_free(StruktsPerfectHash* perfect_hash)
+{
+    if (perfect_hash == NULL)
+        return;
+
+    free(perfect_hash->bits);
+    free(perfect_hash->ranks);
+    free(perfect_hash);
+}
+
+size_t strukts_perfect_hash_index(const StruktsPerfectHash* perfect_hash, const char* key)
+{
+    return strukts_perfect_hash_index_n(perfect_hash, key, strlen(key));
+}
+
+size_t strukts_perfect_hash_index_n(const StruktsPerfectHash* perfect_hash, const void* key,
+                                    size_t key_len)
+{
+    /* most keys are placed by the first level: a single hash and a single rank */
+    for (size_t level = 0; level < perfect_hash->levels_amount; level++) {
+        const size_t bit = perfect_hash->level_offset[level] +
+                           level_position(key, key_len, level, perfect_hash->level_bits[level]);
+
+        if (is_bit_set(perfect_hash->bits, bit))
+            return rank(perfect_hash, bit);
+    }
+
+    return STRUKTS_PERFECT_HASH_NOT_FOUND;
+}
+
+double strukts_perfect_hash_bits_per_key(const StruktsPerfectHash* perfect_hash)
+{
+    if (perfect_hash->keys_amount == 0)
+        return 0;
+
+    const size_t blocks =
+        (perfect_hash->words_amount + STRUKTS_PERFECT_HASH_RANK_WORDS - 1) /
+        STRUKTS_PERFECT_HASH_RANK_WORDS;
+
+    return (double)((perfect_hash->words_amount + blocks) * WORD_BITS) /
+           (double)perfect_hash->keys_amount;
+}
@@ -0,0 +1,221 @@
+#include "strukts_robinhood_hashmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "strukts_hashing.h"
+
+#ifdef DEBUG
+#include "sfmalloc.h"
+#define malloc sf_malloc
+#define free sf_free
+#define calloc sf_calloc
+#endif
+
+/********************** STATIC INLINE FUNCTIONS **********************/
+static inline uint32_t hash_key(const char* key)
+{
+    return strukts_murmur3_hash((const uint8_t*)key, strlen(key), 0);
+}
+
+static inline size_t next_slot(const StruktsRobinHoodHashmap* hashmap, size_t i)
+{
+    return (i + 1) & (hashmap->capacity - 1);
+}
+
+/********************** PRIVATE FUNCTIONS **********************/
+static StruktsRobinHoodHashmapSlot* robinhood_find(const StruktsRobinHoodHashmap* hashmap,
+                                                   const char* key, uint32_t hash)
+{
+    size_t i = hash & (hashmap->capacity - 1);
+
+    /*
+     * Keys are ordered by their distances along a probe sequence: once a slot is closer to its home
+     * than the probe (including empty slots whose distance is 0), the key can't be further ahead.
+     */
+    for (uint32_t distance = 1; hashmap->slots[i].distance >= distance; distance++) {
+        StruktsRobinHoodHashmapSlot* slot = &hashmap->slots[i];
+
+        if (slot->hash == hash && strcmp(slot->key, key) == 0)
+            return slot;
+
+        i = next_slot(hashmap, i);
+    }
+
+    return NULL;
+}
+
+static void robinhood_insert_new(StruktsRobinHoodHashmap* hashmap, const char* key, char* value,
+                                 uint32_t hash)
+{
+    StruktsRobinHoodHashmapSlot carried = {.key = key, .value = value, .hash = hash, .distance = 1};
+    size_t i = hash & (hashmap->capacity - 1);
+
+    while (hashmap->slots[i].distance != 0) {
+        StruktsRobinHoodHashmapSlot* slot = &hashmap->slots[i];
+
+        /* the carried key is poorer (further from home): it takes the slot of the richer key */
+        if (slot->distance < carried.distance) {
+            StruktsRobinHoodHashmapSlot displaced = *slot;
+
+            *slot = carried;
+            carried = displaced;
+        }
+
+        carried.distance++;
+        i = next_slot(hashmap, i);
+    }
+
+    hashmap->slots[i] = carried;
+    hashmap->size++;
+}
+
+static bool robinhood_resize(StruktsRobinHoodHashmap* hashmap, size_t new_capacity)
+{
+    const size_t old_capacity = hashmap->capacity;
+    StruktsRobinHoodHashmapSlot* old_slots = hashmap->slots;
+    StruktsRobinHoodHashmapSlot* slots =
+        (StruktsRobinHoodHashmapSlot*)calloc(new_capacity, sizeof(StruktsRobinHoodHashmapSlot));
+
+    /* on failure, the hashmap keeps its current slots untouched */
+    if (slots == NULL)
+        return false;
+
+    hashmap->slots = slots;
+    hashmap->capacity = new_capacity;
+    hashmap->size = 0;
+
+    /* keys are known to be unique and their hashes are stored: no lookups or hashing are needed */
+    for (size_t i = 0; i < old_capacity; i++) {
+        StruktsRobinHoodHashmapSlot* slot = &old_slots[i];
+
+        if (slot->distance != 0)
+            robinhood_insert_new(hashmap, slot->key, slot->value, slot->hash);
+    }
+
+    free(old_slots);
+
+    return true;
+}
+
+static bool is_resizing_needed(const StruktsRobinHoodHashmap* hashmap)
+{
+    /* load factor after the new key is added */
+    return (double)(hashmap->size + 1) / (double)hashmap->capacity >
+           STRUKTS_ROBINHOOD_HASHMAP_MAX_LOAD_FACTOR;
+}
+
+/********************** PUBLIC FUNCTIONS **********************/
+StruktsRobinHoodHashmap* strukts_robinhood_hashmap_new()
+{
+    StruktsRobinHoodHashmap* hashmap =
+        (StruktsRobinHoodHashmap*)malloc(sizeof(StruktsRobinHoodHashmap));
+
+    if (hashmap == NULL)
+        return NULL;
+
+    /* calloc: every slot starts empty (distance 0) */
+    hashmap->size = 0;
+    hashmap->capacity = STRUKTS_ROBINHOOD_HASHMAP_INITIAL_CAPACITY;
+    hashmap->slots = (StruktsRobinHoodHashmapSlot*)calloc(hashmap->capacity,
+                                                          sizeof(StruktsRobinHoodHashmapSlot));
+
+    if (hashmap->slots == NULL) {
+        free(hashmap);
+
+        return NULL;
+    }
+
+    return hashmap;
+}
+
+void strukts_robinhood_hashmap_free(StruktsRobinHoodHashmap* hashmap)
+{
+    if (hashmap == NULL)
+        return;
+
+    free(hashmap->slots);
+    free(hashmap);
+}
+
+bool strukts_robinhood_hashmap_upsert(StruktsRobinHoodHashmap* hashmap, const char* key,
+                                      char* value)
+{
+    uint32_t hash = hash_key(key);
+    StruktsRobinHoodHashmapSlot* slot = robinhood_find(hashmap, key, hash);
+
+    /* existing keys just have their values replaced */
+    if (slot != NULL) {
+        slot->value = value;
+
+        return true;
+    }
+
+    if (is_resizing_needed(hashmap) && !robinhood_resize(hashmap, 2 * hashmap->capacity))
+        return false;
+
+    robinhood_insert_new(hashmap, key, value, hash);
+
+    return true;
+}
+
+bool strukts_robinhood_hashmap_remove(StruktsRobinHoodHashmap* hashmap, const char* key)
+{
+    StruktsRobinHoodHashmapSlot* slot = robinhood_find(hashmap, key, hash_key(key));
+
+    if (slot == NULL)
+        return false;
+
+    size_t hole = (size_t)(slot - hashmap->slots);
+    size_t i = next_slot(hashmap, hole);
+
+    /* backward shift: following keys move one slot closer to home until an empty/home slot */
+    while (hashmap->slots[i].distance > 1) {
+        hashmap->slots[hole] = hashmap->slots[i];
+        hashmap->slots[hole].distance--;
+
+        hole = i;
+        i = next_slot(hashmap, i);
+    }
+
+    memset(&hashmap->slots[hole], 0, sizeof(StruktsRobinHoodHashmapSlot));
+    hashmap->size--;
+
+    return true;
+}
+
+char* strukts_robinhood_hashmap_get(const StruktsRobinHoodHashmap* hashmap, const char* key)
+{
+    StruktsRobinHoodHashmapSlot* slot = robinhood_find(hashmap, key, hash_key(key));
+
+    if (slot == NULL)
+        return NULL;
+
+    return slot->value;
+}
+
+StruktsRobinHoodHashmapProbeStats strukts_robinhood_hashmap_probe_stats(
+    const StruktsRobinHoodHashmap* hashmap)
+{
+    StruktsRobinHoodHashmapProbeStats stats = {.max_probe_length = 0, .mean_probe_length = 0.0};
+    size_t total_probe_length = 0;
+
+    for (size_t i = 0; i < hashmap->capacity; i++) {
+        uint32_t distance = hashmap->slots[i].distance;
+
+        if (distance == 0)
+            continue;
+
+        total_probe_length += distance - 1;
+
+        if (distance - 1 > stats.max_probe_length)
+            stats.max_probe_length = distance - 1;
+    }
+
+    if (hashmap->size > 0)
+        stats.mean_probe_length = (double)total_probe_length / (double)hashmap->size;
+
+    return stats;
+}
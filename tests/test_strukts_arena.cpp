@@ -0,0 +1,40 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "strukts_arena.h"
+
+namespace
+{
+    TEST(STRUKTS_ARENA_SUITE, SHOULD_ALLOCATE_ITEMS_FROM_SLABS_AND_RECYCLE_RELEASED_ITEMS)
+    {
+        /* arrange */
+        StruktsArena* arena = strukts_arena_new(24, 4);
+        char* items[5];
+
+        /* act - allocates more items than a single slab holds */
+        for (int i = 0; i < 5; i++) {
+            items[i] = (char*)strukts_arena_alloc(arena);
+            memset(items[i], i, 24);
+        }
+
+        /* assert - 5 items require 2 slabs of 4 items */
+        EXPECT_EQ(arena->slabs_amount, 2);
+        EXPECT_EQ(arena->remaining_items, 3);
+        EXPECT_EQ(items[1] - items[0], (long)arena->item_size);
+        EXPECT_EQ((uintptr_t)items[0] % STRUKTS_ARENA_CACHE_LINE, 0);
+        EXPECT_EQ(items[4][23], 4);
+
+        /* act - released items are recycled before new ones are handed out */
+        strukts_arena_release(arena, items[2]);
+        char* recycled = (char*)strukts_arena_alloc(arena);
+
+        /* assert */
+        EXPECT_EQ(recycled, items[2]);
+        EXPECT_EQ(arena->remaining_items, 3);
+        EXPECT_EQ(strukts_arena_allocated_bytes(arena) > 8 * arena->item_size, true);
+
+        strukts_arena_free(arena);
+    }
+}  // namespace
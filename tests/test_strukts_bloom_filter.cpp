@@ -0,0 +1,167 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "strukts_bloom_filter.h"
+#include "strukts_hashing.h"
+
+namespace
+{
+    TEST(STRUKTS_BLOOM_FILTER_SUITE, SHOULD_NEVER_REJECT_ADDED_KEYS)
+    {
+        /* arrange */
+        StruktsBloomFilter* filter =
+            strukts_bloom_filter_new(10000, 0.01, STRUKTS_BLOOM_FILTER_DEFAULT);
+        StruktsBloomFilter* blocked =
+            strukts_bloom_filter_new(10000, 0.01, STRUKTS_BLOOM_FILTER_BLOCKED);
+
+        ASSERT_TRUE(filter != NULL);
+        ASSERT_TRUE(blocked != NULL);
+
+        /* act */
+        for (int i = 0; i < 10000; i++) {
+            std::string key = "key-" + std::to_string(i);
+
+            strukts_bloom_filter_add(filter, key.c_str());
+            strukts_bloom_filter_add_n(blocked, key.data(), key.size());
+        }
+
+        /* assert */
+        EXPECT_EQ(filter->keys_amount, 10000);
+        EXPECT_EQ(filter->bits_amount % STRUKTS_BLOOM_FILTER_BLOCK_BITS, 0);
+        EXPECT_EQ(filter->hashes_amount, 7); /* ~9.6 bits per key for 1% */
+
+        for (int i = 0; i < 10000; i++) {
+            std::string key = "key-" + std::to_string(i);
+
+            EXPECT_TRUE(strukts_bloom_filter_might_contain(filter, key.c_str()));
+            EXPECT_TRUE(strukts_bloom_filter_might_contain_n(blocked, key.data(), key.size()));
+        }
+
+        strukts_bloom_filter_free(filter);
+        strukts_bloom_filter_free(blocked);
+    }
+
+    TEST(STRUKTS_BLOOM_FILTER_SUITE, SHOULD_KEEP_FALSE_POSITIVE_RATE_CLOSE_TO_TARGET)
+    {
+        /* arrange */
+        StruktsBloomFilter* filter =
+            strukts_bloom_filter_new(10000, 0.01, STRUKTS_BLOOM_FILTER_DEFAULT);
+        StruktsBloomFilter* blocked =
+            strukts_bloom_filter_new(10000, 0.01, STRUKTS_BLOOM_FILTER_BLOCKED);
+        int false_positives = 0;
+        int blocked_false_positives = 0;
+
+        for (int i = 0; i < 10000; i++) {
+            std::string key = "key-" + std::to_string(i);
+
+            strukts_bloom_filter_add(filter, key.c_str());
+            strukts_bloom_filter_add(blocked, key.c_str());
+        }
+
+        /* act */
+        for (int i = 0; i < 100000; i++) {
+            std::string missing_key = "missing-" + std::to_string(i);
+
+            false_positives += strukts_bloom_filter_might_contain(filter, missing_key.c_str());
+            blocked_false_positives +=
+                strukts_bloom_filter_might_contain(blocked, missing_key.c_str());
+        }
+
+        /* assert: 1% target (the blocked layout trades a slightly higher rate for locality) */
+        EXPECT_LT(false_positives, 2000);
+        EXPECT_LT(blocked_false_positives, 3000);
+
+        strukts_bloom_filter_free(filter);
+        strukts_bloom_filter_free(blocked);
+    }
+
+    TEST(STRUKTS_BLOOM_FILTER_SUITE, SHOULD_SET_ALL_BITS_OF_A_KEY_IN_ONE_CACHE_LINE_WHEN_BLOCKED)
+    {
+        /* arrange */
+        StruktsBloomFilter* filter =
+            strukts_bloom_filter_new(1000, 0.01, STRUKTS_BLOOM_FILTER_BLOCKED);
+        const size_t words_amount = filter->bits_amount / 64;
+        size_t first_word = words_amount;
+        size_t last_word = 0;
+        int bits_set = 0;
+
+        /* act */
+        strukts_bloom_filter_add(filter, "single-key");
+
+        /* assert */
+        EXPECT_EQ((uintptr_t)filter->words % 64, 0);
+
+        for (size_t i = 0; i < words_amount; i++) {
+            if (filter->words[i] == 0)
+                continue;
+
+            bits_set += __builtin_popcountll(filter->words[i]);
+            first_word = i < first_word ? i : first_word;
+            last_word = i;
+        }
+
+        EXPECT_GT(bits_set, 0);
+        EXPECT_LE(bits_set, (int)filter->hashes_amount);
+        EXPECT_EQ(first_word / 8, last_word / 8); /* 8 words: a 64-byte block */
+
+        strukts_bloom_filter_free(filter);
+    }
+
+    TEST(STRUKTS_BLOOM_FILTER_SUITE, SHOULD_SET_K_DISTINCT_BITS_PER_KEY_WHEN_BLOCKED)
+    {
+        /* arrange - second hashes whose rotation is even or a multiple of the block's bits */
+        const uint32_t alt_hashes[4] = {0, 1u << 17, 512u << 17, 0x80000000u};
+
+        for (size_t a = 0; a < 4; a++) {
+            StruktsBloomFilter* filter =
+                strukts_bloom_filter_new(1000, 0.01, STRUKTS_BLOOM_FILTER_BLOCKED);
+            int bits_set = 0;
+
+            /* act */
+            strukts_bloom_filter_add_hashes(filter, 12345, alt_hashes[a]);
+
+            /* assert - the key's bits never repeat inside its block */
+            for (size_t i = 0; i < filter->bits_amount / 64; i++)
+                bits_set += __builtin_popcountll(filter->words[i]);
+
+            EXPECT_EQ(bits_set, (int)filter->hashes_amount);
+
+            strukts_bloom_filter_free(filter);
+        }
+    }
+
+    TEST(STRUKTS_BLOOM_FILTER_SUITE, SHOULD_REJECT_KEYS_BY_FIRST_HASH_WITHOUT_SECOND_HASH)
+    {
+        /* arrange */
+        unsigned int flags_list[2] = {STRUKTS_BLOOM_FILTER_DEFAULT, STRUKTS_BLOOM_FILTER_BLOCKED};
+        const uint32_t hash =
+            strukts_murmur3_hash((const uint8_t*)"key", 3, STRUKTS_BLOOM_FILTER_SEED);
+
+        for (size_t f = 0; f < 2; f++) {
+            StruktsBloomFilter* filter = strukts_bloom_filter_new(1000, 0.01, flags_list[f]);
+
+            /* act & assert - nothing added yet: every first hash is rejected */
+            EXPECT_FALSE(strukts_bloom_filter_might_contain_first_hash(filter, hash));
+
+            /* act & assert - added keys always pass the first hash pre-check */
+            strukts_bloom_filter_add(filter, "key");
+
+            EXPECT_TRUE(strukts_bloom_filter_might_contain_first_hash(filter, hash));
+
+            strukts_bloom_filter_free(filter);
+        }
+    }
+
+    TEST(STRUKTS_BLOOM_FILTER_SUITE, SHOULD_NOT_CREATE_BLOOM_FILTER_WITH_INVALID_RATE)
+    {
+        /* act & assert */
+        EXPECT_TRUE(strukts_bloom_filter_new(100, 0, STRUKTS_BLOOM_FILTER_DEFAULT) == NULL);
+        EXPECT_TRUE(strukts_bloom_filter_new(100, 1, STRUKTS_BLOOM_FILTER_DEFAULT) == NULL);
+        EXPECT_TRUE(strukts_bloom_filter_new(100, -0.5, STRUKTS_BLOOM_FILTER_BLOCKED) == NULL);
+    }
+}  // namespace
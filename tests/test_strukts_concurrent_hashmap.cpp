@@ -0,0 +1,101 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_concurrent_hashmap.h"
+#include "strukts_hashing.h"
+
+namespace
+{
+    TEST(STRUKTS_CONCURRENT_HASHMAP_SUITE, SHOULD_ROUND_SHARDS_UP_TO_POWER_OF_2)
+    {
+        /* arrange & act */
+        StruktsConcurrentHashmap* dict = strukts_concurrent_hashmap_new(6, STRUKTS_HASHMAP_DEFAULT);
+
+        /* assert */
+        EXPECT_EQ(dict->shards_amount, 8);
+        EXPECT_EQ(dict->shard_bits, 3);
+        EXPECT_EQ((uintptr_t)dict->shards % STRUKTS_CONCURRENT_HASHMAP_CACHE_LINE, 0);
+
+        strukts_concurrent_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_CONCURRENT_HASHMAP_SUITE, SHOULD_ADD_AND_GET_KEYS_FROM_MANY_THREADS)
+    {
+        /* arrange */
+        const int threads_amount = 4;
+        const int keys_per_thread = 500;
+        static char keys[4][500][16];
+        StruktsConcurrentHashmap* dict = strukts_concurrent_hashmap_new(4, STRUKTS_HASHMAP_ARENA);
+        std::vector<std::thread> threads;
+        bool all_found[4] = {true, true, true, true};
+
+        /* act - each thread upserts its own keys while reading the keys it added before */
+        for (int t = 0; t < threads_amount; t++) {
+            threads.push_back(std::thread([&, t]() {
+                for (int i = 0; i < keys_per_thread; i++) {
+                    snprintf(keys[t][i], sizeof(keys[t][i]), "t%d-k%d", t, i);
+                    strukts_concurrent_hashmap_upsert(dict, keys[t][i], keys[t][i]);
+
+                    char* value = strukts_concurrent_hashmap_get(dict, keys[t][i / 2]);
+                    all_found[t] = all_found[t] && value != NULL;
+                }
+            }));
+        }
+
+        for (size_t t = 0; t < threads.size(); t++)
+            threads[t].join();
+
+        /* assert */
+        EXPECT_EQ(strukts_concurrent_hashmap_size(dict), threads_amount * keys_per_thread);
+
+        for (int t = 0; t < threads_amount; t++) {
+            EXPECT_TRUE(all_found[t]);
+            EXPECT_EQ(strcmp(strukts_concurrent_hashmap_get(dict, keys[t][42]), keys[t][42]), 0);
+        }
+
+        /* act - removals */
+        EXPECT_TRUE(strukts_concurrent_hashmap_remove(dict, keys[0][0]));
+        EXPECT_FALSE(strukts_concurrent_hashmap_remove(dict, keys[0][0]));
+        EXPECT_TRUE(strukts_concurrent_hashmap_get(dict, keys[0][0]) == NULL);
+
+        strukts_concurrent_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_CONCURRENT_HASHMAP_SUITE, SHOULD_PICK_SHARDS_WITH_THE_SHARDS_OWN_HASH)
+    {
+        /* arrange - keys are built in a buffer, so shards own copies of them */
+        StruktsConcurrentHashmap* dict = strukts_concurrent_hashmap_new(
+            8, STRUKTS_HASHMAP_MURMUR3_128 | STRUKTS_HASHMAP_OWN_KEYS);
+        char key[32];
+
+        /* act */
+        for (int i = 0; i < 100; i++) {
+            snprintf(key, sizeof(key), "key-%d", i);
+            strukts_concurrent_hashmap_upsert(dict, key, (char*)"value");
+        }
+
+        /* assert - a key lives in the shard picked by the high bits of its 128-bit hash */
+        for (int i = 0; i < 100; i++) {
+            uint64_t hash[2];
+
+            snprintf(key, sizeof(key), "key-%d", i);
+            strukts_murmur3_hash_x64_128((const uint8_t*)key, strlen(key), 0, hash);
+
+            StruktsHashmap* shard = dict->shards[(uint32_t)hash[0] >> 29].hashmap;
+
+            EXPECT_TRUE(strukts_hashmap_get(shard, key) != NULL);
+            EXPECT_EQ(strcmp(strukts_concurrent_hashmap_get(dict, key), "value"), 0);
+        }
+
+        EXPECT_TRUE(strukts_concurrent_hashmap_remove(dict, "key-42"));
+        EXPECT_TRUE(strukts_concurrent_hashmap_get(dict, "key-42") == NULL);
+
+        strukts_concurrent_hashmap_free(dict);
+    }
+}  // namespace
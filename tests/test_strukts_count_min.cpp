@@ -0,0 +1,83 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_count_min.h"
+
+namespace
+{
+    TEST(STRUKTS_COUNT_MIN_SUITE, SHOULD_SIZE_COUNT_MIN_FROM_EPSILON_AND_DELTA)
+    {
+        /* act */
+        StruktsCountMin* sketch = strukts_count_min_new(0.01, 0.01);
+
+        /* assert: e / 0.01 ~ 272 -> 512 and ln(100) ~ 4.6 -> 5 */
+        ASSERT_TRUE(sketch != NULL);
+        EXPECT_EQ(sketch->width, 512);
+        EXPECT_EQ(sketch->depth, 5);
+        EXPECT_EQ(strukts_count_min_estimate(sketch, "any"), 0);
+
+        EXPECT_TRUE(strukts_count_min_new(0, 0.01) == NULL);
+        EXPECT_TRUE(strukts_count_min_new(0.01, 1) == NULL);
+
+        strukts_count_min_free(sketch);
+    }
+
+    TEST(STRUKTS_COUNT_MIN_SUITE, SHOULD_NEVER_UNDERESTIMATE_AND_FIND_HEAVY_HITTERS)
+    {
+        /* arrange - key-i is added i % 10 + 1 times and "heavy" is added 10000 times */
+        StruktsCountMin* sketch = strukts_count_min_new(0.001, 0.01);
+        std::vector<std::string> keys;
+        std::vector<const char*> key_pointers;
+
+        for (int i = 0; i < 1000; i++)
+            for (int j = 0; j <= i % 10; j++)
+                keys.push_back("key-" + std::to_string(i));
+
+        for (size_t i = 0; i < keys.size(); i++)
+            key_pointers.push_back(keys[i].c_str());
+
+        /* act */
+        strukts_count_min_add_many(sketch, key_pointers.data(), key_pointers.size());
+        strukts_count_min_add(sketch, "heavy", 9999);
+        strukts_count_min_add_n(sketch, "heavy-suffix", 5, 1);
+
+        /* assert: estimates exceed real counts by at most epsilon * total (~15) */
+        const uint32_t error = (uint32_t)(0.001 * (double)sketch->total) + 1;
+
+        EXPECT_EQ(sketch->total, keys.size() + 10000);
+        EXPECT_GE(strukts_count_min_estimate(sketch, "heavy"), 10000);
+        EXPECT_LE(strukts_count_min_estimate(sketch, "heavy"), 10000 + error);
+
+        for (int i = 0; i < 1000; i++) {
+            std::string key = "key-" + std::to_string(i);
+            uint32_t estimate = strukts_count_min_estimate_n(sketch, key.data(), key.size());
+
+            EXPECT_GE(estimate, (uint32_t)(i % 10 + 1));
+            EXPECT_LE(estimate, (uint32_t)(i % 10 + 1) + error);
+        }
+
+        strukts_count_min_free(sketch);
+    }
+
+    TEST(STRUKTS_COUNT_MIN_SUITE, SHOULD_SATURATE_COUNTERS)
+    {
+        /* arrange */
+        StruktsCountMin* sketch = strukts_count_min_new(0.1, 0.1);
+
+        /* act */
+        strukts_count_min_add(sketch, "key", UINT32_MAX - 1);
+        strukts_count_min_add(sketch, "key", 10);
+
+        /* assert */
+        EXPECT_EQ(strukts_count_min_estimate(sketch, "key"), UINT32_MAX);
+        EXPECT_EQ(sketch->total, (uint64_t)UINT32_MAX + 9);
+
+        strukts_count_min_free(sketch);
+    }
+}  // namespace
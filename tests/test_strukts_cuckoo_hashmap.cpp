@@ -0,0 +1,85 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "strukts_cuckoo_hashmap.h"
+#include "strukts_hashing.h"
+
+namespace
+{
+    bool is_in_candidate_bucket(const StruktsCuckooHashmap* dict, const char* key)
+    {
+        size_t key_len = strlen(key);
+        uint32_t hash =
+            strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_SEED);
+        uint32_t alt_hash =
+            strukts_murmur3_hash((const uint8_t*)key, key_len, STRUKTS_CUCKOO_HASHMAP_ALT_SEED);
+        size_t candidates[2] = {hash & (dict->buckets_amount - 1),
+                                alt_hash & (dict->buckets_amount - 1)};
+
+        for (size_t i = 0; i < 2; i++) {
+            for (size_t slot = 0; slot < STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS; slot++) {
+                if (dict->buckets[candidates[i]].keys[slot] == key)
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    TEST(STRUKTS_CUCKOO_HASHMAP_SUITE, SHOULD_KEEP_EVERY_KEY_IN_ONE_OF_ITS_TWO_BUCKETS)
+    {
+        /* arrange */
+        const int keys_amount = 5000;
+        static char keys[5000][16];
+        StruktsCuckooHashmap* dict = strukts_cuckoo_hashmap_new();
+
+        /* act */
+        for (int i = 0; i < keys_amount; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key-%d", i);
+            EXPECT_TRUE(strukts_cuckoo_hashmap_upsert(dict, keys[i], keys[i]));
+        }
+
+        /* assert */
+        EXPECT_EQ(dict->size, keys_amount);
+        EXPECT_EQ(sizeof(StruktsCuckooHashmapBucket), STRUKTS_CUCKOO_HASHMAP_CACHE_LINE);
+        EXPECT_EQ((uintptr_t)dict->buckets % STRUKTS_CUCKOO_HASHMAP_CACHE_LINE, 0);
+        EXPECT_GT((double)dict->size / (dict->buckets_amount * STRUKTS_CUCKOO_HASHMAP_BUCKET_SLOTS),
+                  0.5);
+
+        for (int i = 0; i < keys_amount; i++) {
+            EXPECT_TRUE(is_in_candidate_bucket(dict, keys[i]));
+            EXPECT_EQ(strukts_cuckoo_hashmap_get(dict, keys[i]), keys[i]);
+        }
+
+        EXPECT_TRUE(strukts_cuckoo_hashmap_get(dict, "key-unknown") == NULL);
+
+        strukts_cuckoo_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_CUCKOO_HASHMAP_SUITE, SHOULD_REPLACE_AND_REMOVE_KEYS)
+    {
+        /* arrange */
+        StruktsCuckooHashmap* dict = strukts_cuckoo_hashmap_new();
+        char value1[] = "value1";
+        char value2[] = "value2";
+
+        /* act */
+        strukts_cuckoo_hashmap_upsert(dict, "key", value1);
+        strukts_cuckoo_hashmap_upsert(dict, "key", value2);
+
+        /* assert */
+        EXPECT_EQ(dict->size, 1);
+        EXPECT_EQ(strukts_cuckoo_hashmap_get(dict, "key"), value2);
+
+        /* act & assert */
+        EXPECT_TRUE(strukts_cuckoo_hashmap_remove(dict, "key"));
+        EXPECT_FALSE(strukts_cuckoo_hashmap_remove(dict, "key"));
+        EXPECT_TRUE(strukts_cuckoo_hashmap_get(dict, "key") == NULL);
+        EXPECT_EQ(dict->size, 0);
+
+        strukts_cuckoo_hashmap_free(dict);
+    }
+}  // namespace
@@ -0,0 +1,69 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+#include "strukts_epoch.h"
+
+namespace
+{
+    int freed_objects = 0;
+
+    void count_free(void* object)
+    {
+        (void)object;
+        freed_objects++;
+    }
+
+    TEST(STRUKTS_EPOCH_SUITE, SHOULD_NOT_RECLAIM_WHILE_READER_IS_IN_OLDER_EPOCH)
+    {
+        /* arrange */
+        int object = 42;
+        StruktsEpochDomain* domain = strukts_epoch_domain_new(4);
+        StruktsEpochReader* reader = strukts_epoch_reader_register(domain);
+        freed_objects = 0;
+
+        /* act - a reader enters epoch 0 and the object is retired during epoch 0 */
+        strukts_epoch_enter(domain, reader);
+        EXPECT_TRUE(strukts_epoch_retire(domain, &object, count_free));
+
+        /* assert - the reader has observed epoch 0, so the epoch advances once but not twice */
+        EXPECT_TRUE(strukts_epoch_try_reclaim(domain));
+        EXPECT_FALSE(strukts_epoch_try_reclaim(domain));
+        EXPECT_EQ(domain->global_epoch, 1);
+        EXPECT_EQ(freed_objects, 0);
+
+        /* act - the reader leaves its critical section */
+        strukts_epoch_exit(reader);
+
+        /* assert - the object is reclaimed two epochs after its retirement */
+        EXPECT_TRUE(strukts_epoch_try_reclaim(domain));
+        EXPECT_EQ(domain->global_epoch, 2);
+        EXPECT_EQ(freed_objects, 1);
+        EXPECT_EQ(domain->retired_amount, 0);
+
+        strukts_epoch_reader_unregister(domain, reader);
+        strukts_epoch_domain_free(domain);
+    }
+
+    TEST(STRUKTS_EPOCH_SUITE, SHOULD_LIMIT_REGISTERED_READERS)
+    {
+        /* arrange */
+        StruktsEpochDomain* domain = strukts_epoch_domain_new(2);
+
+        /* act */
+        StruktsEpochReader* first = strukts_epoch_reader_register(domain);
+        StruktsEpochReader* second = strukts_epoch_reader_register(domain);
+        StruktsEpochReader* third = strukts_epoch_reader_register(domain);
+
+        /* assert */
+        EXPECT_TRUE(first != NULL);
+        EXPECT_TRUE(second != NULL);
+        EXPECT_TRUE(third == NULL);
+        EXPECT_EQ((uintptr_t)first % STRUKTS_EPOCH_CACHE_LINE, 0);
+
+        strukts_epoch_reader_unregister(domain, first);
+        EXPECT_EQ(strukts_epoch_reader_register(domain), first);
+
+        strukts_epoch_domain_free(domain);
+    }
+}  // namespace
@@ -0,0 +1,55 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "strukts_flathashmap.h"
+
+namespace
+{
+    TEST(STRUKTS_FLATHASHMAP_SUITE, SHOULD_ADD_KEY_VALUE_TO_FLATHASHMAP_WITH_RESIZING)
+    {
+        /* arrange */
+        char keys[100][16];
+        bool all_added = true;
+        StruktsFlatHashmap* dict = strukts_flathashmap_new();
+
+        /* act - adds enough keys to trigger resizing a few times (16 -> 32 -> 64 -> 128) */
+        for (int i = 0; i < 100; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+            all_added = all_added && strukts_flathashmap_add(dict, keys[i], keys[i]);
+        }
+
+        /* assert */
+        EXPECT_TRUE(all_added);
+        EXPECT_EQ(dict->size, 100);
+        EXPECT_EQ(dict->capacity, 128);
+
+        for (int i = 0; i < 100; i++) {
+            char* value = strukts_flathashmap_get(dict, keys[i]);
+
+            ASSERT_TRUE(value != NULL);
+            EXPECT_EQ(strcmp(value, keys[i]), 0);
+        }
+
+        strukts_flathashmap_free(dict);
+    }
+
+    TEST(STRUKTS_FLATHASHMAP_SUITE, SHOULD_REPLACE_VALUE_OF_EXISTING_KEY_AND_MISS_UNKNOWN_KEYS)
+    {
+        /* arrange */
+        StruktsFlatHashmap* dict = strukts_flathashmap_new();
+
+        /* act */
+        strukts_flathashmap_add(dict, "k1", (char*)"v1");
+        strukts_flathashmap_add(dict, "k1", (char*)"v2");
+
+        /* assert */
+        EXPECT_EQ(dict->size, 1);
+        EXPECT_EQ(strcmp(strukts_flathashmap_get(dict, "k1"), "v2"), 0);
+        EXPECT_TRUE(strukts_flathashmap_get(dict, "k2") == NULL);
+
+        strukts_flathashmap_free(dict);
+    }
+}  // namespace
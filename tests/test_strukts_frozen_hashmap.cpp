@@ -0,0 +1,67 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_frozen_hashmap.h"
+
+namespace
+{
+    TEST(STRUKTS_FROZEN_HASHMAP_SUITE, SHOULD_GET_VALUES_OF_STATIC_KEYS)
+    {
+        /* arrange */
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        std::vector<const char*> key_pointers;
+        std::vector<char*> value_pointers;
+
+        for (int i = 0; i < 1000; i++) {
+            keys.push_back("key-" + std::to_string(i));
+            values.push_back("value-" + std::to_string(i));
+        }
+
+        for (size_t i = 0; i < keys.size(); i++) {
+            key_pointers.push_back(keys[i].c_str());
+            value_pointers.push_back((char*)values[i].c_str());
+        }
+
+        /* act */
+        StruktsFrozenHashmap* hashmap =
+            strukts_frozen_hashmap_new(key_pointers.data(), value_pointers.data(), keys.size());
+
+        /* assert */
+        ASSERT_TRUE(hashmap != NULL);
+        EXPECT_EQ(hashmap->size, 1000);
+
+        for (size_t i = 0; i < keys.size(); i++)
+            EXPECT_EQ(strukts_frozen_hashmap_get(hashmap, keys[i].c_str()), value_pointers[i]);
+
+        EXPECT_EQ(strukts_frozen_hashmap_get_n(hashmap, "key-42-suffix", 6), value_pointers[42]);
+
+        /* keys that are not in the set are rejected by the key comparison */
+        for (int i = 1000; i < 2000; i++) {
+            std::string missing_key = "key-" + std::to_string(i);
+
+            EXPECT_TRUE(strukts_frozen_hashmap_get(hashmap, missing_key.c_str()) == NULL);
+        }
+
+        strukts_frozen_hashmap_free(hashmap);
+    }
+
+    TEST(STRUKTS_FROZEN_HASHMAP_SUITE, SHOULD_NOT_CREATE_FROZEN_HASHMAP_WITH_DUPLICATE_KEYS)
+    {
+        /* arrange */
+        const char* keys[2] = {"k1", "k1"};
+        char* values[2] = {(char*)"v1", (char*)"v2"};
+
+        /* act */
+        StruktsFrozenHashmap* hashmap = strukts_frozen_hashmap_new(keys, values, 2);
+
+        /* assert */
+        EXPECT_TRUE(hashmap == NULL);
+    }
+}  // namespace
@@ -52,4 +52,151 @@ namespace
         /* assert */
         EXPECT_EQ(hash, -464589223);  // expectation from python's lib mmh3
     }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_128BIT_MURMUR3_HASH_STRINGS_WITH_TAILS_OF_EVERY_LANE)
+    {
+        /* arrange */
+        const char* fox = "The quick brown fox jumps over the lazy dog"; /* 2 blocks + 11 bytes */
+        const char* short_str = "abcde";                                   /* k1 lane tail only */
+        const char* long_str = "some really nice long key";                /* 1 block + 9 bytes */
+        uint64_t fox_hash[2];
+        uint64_t short_hash[2];
+        uint64_t long_hash[2];
+        uint64_t empty_hash[2];
+
+        /* act */
+        strukts_murmur3_hash_x64_128((const BYTE*)fox, strlen(fox), 0, fox_hash);
+        strukts_murmur3_hash_x64_128((const BYTE*)short_str, strlen(short_str), 0, short_hash);
+        strukts_murmur3_hash_x64_128((const BYTE*)long_str, strlen(long_str), 10, long_hash);
+        strukts_murmur3_hash_x64_128((const BYTE*)"", 0, 0, empty_hash);
+
+        /* assert - expectations from python's lib mmh3 (hash128, x64 variant) */
+        EXPECT_EQ(fox_hash[0], 0xe34bbc7bbc071b6cull);
+        EXPECT_EQ(fox_hash[1], 0x7a433ca9c49a9347ull);
+        EXPECT_EQ(short_hash[0], 0x2036d091f496bbb8ull);
+        EXPECT_EQ(short_hash[1], 0xc5c7eea04bcfec8cull);
+        EXPECT_EQ(long_hash[0], 0xdb2a4de920a57e2cull);
+        EXPECT_EQ(long_hash[1], 0x962225fb3c6c524full);
+        EXPECT_EQ(empty_hash[0], 0ull);
+        EXPECT_EQ(empty_hash[1], 0ull);
+    }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_128BIT_MURMUR3_HASH_1KB_STRING)
+    {
+        /* arrange */
+        char str[1004];
+        uint64_t hash[2];
+
+        memset(str, 'a', 1000);
+        memcpy(str + 1000, "xyz", 4);
+
+        /* act */
+        strukts_murmur3_hash_x64_128((const BYTE*)str, strlen(str), 7, hash);
+
+        /* assert */
+        EXPECT_EQ(hash[0], 0xe11fb2acb6fba7c1ull);  // expectation from python's lib mmh3
+        EXPECT_EQ(hash[1], 0x57e131af3f161297ull);
+    }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_STREAM_MURMUR3_HASH_OF_EVERY_SPLIT_OF_A_KEY)
+    {
+        /* arrange */
+        const char str[50] = "some really nice long key";
+        const BYTE* str_bytes = (BYTE*)str;
+        size_t str_len = strlen(str);
+
+        /* act & assert - two fragments, split at every position, with the one-shot expectation */
+        for (size_t split = 0; split <= str_len; split++) {
+            StruktsMurmur3Context context;
+
+            strukts_murmur3_init(&context, 10);
+            strukts_murmur3_update(&context, str_bytes, split);
+            strukts_murmur3_update(&context, str_bytes + split, str_len - split);
+
+            EXPECT_EQ(strukts_murmur3_final(&context), -464589223);
+        }
+    }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_STREAM_MURMUR3_HASH_BYTE_BY_BYTE)
+    {
+        /* arrange */
+        const char str[10] = "abcde";
+        const BYTE* str_bytes = (BYTE*)str;
+        StruktsMurmur3Context context;
+        StruktsMurmur3Context empty_context;
+
+        /* act */
+        strukts_murmur3_init(&context, 0);
+        strukts_murmur3_init(&empty_context, 5);
+
+        for (size_t i = 0; i < strlen(str); i++) {
+            strukts_murmur3_update(&context, str_bytes + i, 1);
+            strukts_murmur3_update(&context, str_bytes, 0); /* empty fragments change nothing */
+        }
+
+        /* assert */
+        EXPECT_EQ(strukts_murmur3_final(&context), -392455434);
+        EXPECT_EQ(strukts_murmur3_final(&empty_context), strukts_murmur3_hash(str_bytes, 0, 5));
+    }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_MURMUR3_HASH_IOVEC_FRAGMENTS)
+    {
+        /* arrange - fragments of 3, 0, 6, 1 and 15 bytes */
+        char header[] = "GET";
+        char path[] = " /key/";
+        char separator[] = "4";
+        char tail[] = "2?query=strukts";
+        const char* whole = "GET /key/42?query=strukts";
+        struct iovec fragments[5] = {{header, 3}, {NULL, 0}, {path, 6}, {separator, 1}, {tail, 15}};
+
+        /* act */
+        WORD hash = strukts_murmur3_hash_iov(fragments, 5, 7);
+
+        /* assert */
+        EXPECT_EQ(hash, strukts_murmur3_hash((const BYTE*)whole, strlen(whole), 7));
+    }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_MURMUR3_HASH_MANY_KEYS_LIKE_ONE_BY_ONE_ON_EVERY_LEVEL)
+    {
+        /* arrange - 37 keys: 32 hashed by whole vectors and 5 by the scalar fallback */
+        BYTE buffer[37 * 16];
+        const BYTE* keys[37];
+        WORD hashes[37];
+
+        for (size_t i = 0; i < sizeof(buffer); i++)
+            buffer[i] = (BYTE)(i * 131 + 17);
+
+        for (size_t i = 0; i < 37; i++)
+            keys[i] = buffer + i * 16 + i % 3; /* unaligned keys */
+
+        /* act & assert - every key length (whole blocks and partial final blocks) */
+        for (unsigned int level = STRUKTS_MURMUR3_SCALAR; level <= STRUKTS_MURMUR3_AVX512;
+             level++) {
+            for (size_t key_len = 0; key_len <= 13; key_len++) {
+                memset(hashes, 0, sizeof(hashes));
+                strukts_murmur3_hash_many_with_level(keys, key_len, 37, 42, hashes, level);
+
+                for (size_t i = 0; i < 37; i++)
+                    EXPECT_EQ(hashes[i], strukts_murmur3_hash(keys[i], key_len, 42));
+            }
+        }
+
+        EXPECT_LE(strukts_murmur3_simd_level(), (unsigned int)STRUKTS_MURMUR3_AVX512);
+    }
+
+    TEST(STRUKTS_HASHING_SUITE, SHOULD_MURMUR3_HASH_MANY_KEYS_WITH_BEST_LEVEL)
+    {
+        /* arrange */
+        const char* strs[9] = {"abcde", "abcdf", "abcdg", "abcdh", "abcdi",
+                               "abcdj", "abcdk", "abcdl", "abcde"};
+        WORD hashes[9];
+
+        /* act */
+        strukts_murmur3_hash_many((const BYTE* const*)strs, 5, 9, 0, hashes);
+
+        /* assert */
+        EXPECT_EQ(hashes[0], -392455434);  // expectation from python's lib mmh3
+        EXPECT_EQ(hashes[8], -392455434);
+        EXPECT_NE(hashes[1], hashes[0]);
+    }
 }  // namespace
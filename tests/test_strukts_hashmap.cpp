@@ -3,7 +3,12 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "strukts_hashing.h"
 #include "strukts_hashmap.h"
 
 namespace
@@ -16,7 +21,7 @@ namespace
         StruktsHashmap* dict = strukts_hashmap_new();
 
         /* act - add key/value and search the for the key in the hashmap */
-        added = strukts_hashmap_add(&dict, "k1", (char*)"v1");
+        added = strukts_hashmap_add(dict, "k1", (char*)"v1");
         value = strukts_hashmap_get(dict, "k1");
 
         /* assert */
@@ -26,7 +31,7 @@ namespace
         EXPECT_EQ(strcmp(value, "v1"), 0);
 
         /* act - adding new key should rehash keys from capacity 1 to 2^1 */
-        added = strukts_hashmap_add(&dict, "k2", (char*)"v2");
+        added = strukts_hashmap_add(dict, "k2", (char*)"v2");
         value = strukts_hashmap_get(dict, "k2");
 
         /* assert */
@@ -36,7 +41,7 @@ namespace
         EXPECT_EQ(strcmp(value, "v2"), 0);
 
         /* act - adding new key should rehash keys from capacity 2ˆ1 to 2^2 */
-        added = strukts_hashmap_add(&dict, "k3", (char*)"v3");
+        added = strukts_hashmap_add(dict, "k3", (char*)"v3");
         value = strukts_hashmap_get(dict, "k3");
 
         /* assert */
@@ -46,7 +51,7 @@ namespace
         EXPECT_EQ(strcmp(value, "v3"), 0);
 
         /* act - adding new key should rehash keys from capacity 2^2 to 2^3 */
-        added = strukts_hashmap_add(&dict, "k4", (char*)"v4");
+        added = strukts_hashmap_add(dict, "k4", (char*)"v4");
         value = strukts_hashmap_get(dict, "k4");
 
         /* assert */
@@ -56,7 +61,7 @@ namespace
         EXPECT_EQ(strcmp(value, "v4"), 0);
 
         /* act - adding new key for current load factor should NOT trigger new rehashing */
-        added = strukts_hashmap_add(&dict, "k5", (char*)"v5");
+        added = strukts_hashmap_add(dict, "k5", (char*)"v5");
         value = strukts_hashmap_get(dict, "k5");
 
         /* assert */
@@ -67,4 +72,797 @@ namespace
 
         strukts_hashmap_free(dict);
     }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_KEEP_ALL_KEYS_AFTER_MANY_REHASHINGS)
+    {
+        /* arrange */
+        char keys[200][16];
+        bool all_added = true;
+        StruktsHashmap* dict = strukts_hashmap_new();
+
+        /* act - capacity grows from 1 up to 512 (all keys rehashed at once every time) */
+        for (int i = 0; i < 200; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+            all_added = all_added && strukts_hashmap_add(dict, keys[i], keys[i]);
+        }
+
+        /* assert */
+        EXPECT_TRUE(all_added);
+        EXPECT_EQ(dict->size, 200);
+        EXPECT_EQ(dict->capacity, 512);
+        EXPECT_TRUE(dict->old_buckets == NULL);
+
+        for (int i = 0; i < 200; i++) {
+            char* value = strukts_hashmap_get(dict, keys[i]);
+
+            ASSERT_TRUE(value != NULL);
+            EXPECT_EQ(strcmp(value, keys[i]), 0);
+        }
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_REHASH_INCREMENTALLY_A_FEW_BUCKETS_PER_OPERATION)
+    {
+        /* arrange */
+        char keys[181][16];
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_INCREMENTAL_REHASH);
+
+        /* act - the 181st key finds 180 keys on 256 buckets (>= 0.7) and starts a rehashing */
+        for (int i = 0; i < 181; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+            strukts_hashmap_add(dict, keys[i], keys[i]);
+        }
+
+        /* assert - both bucket arrays live side by side but nothing has been migrated yet */
+        EXPECT_EQ(dict->size, 181);
+        EXPECT_EQ(dict->capacity, 512);
+        EXPECT_EQ(dict->old_capacity, 256);
+        EXPECT_EQ(dict->rehash_index, 0);
+
+        /* act - a lookup migrates a few buckets */
+        char* value = strukts_hashmap_get(dict, keys[0]);
+
+        /* assert */
+        EXPECT_EQ(strcmp(value, keys[0]), 0);
+        EXPECT_EQ(dict->rehash_index, STRUKTS_HASHMAP_REHASH_STEP);
+
+        /* act & assert - every key is reachable while the remaining buckets are migrated */
+        for (int i = 0; i < 181; i++) {
+            value = strukts_hashmap_get(dict, keys[i]);
+
+            ASSERT_TRUE(value != NULL);
+            EXPECT_EQ(strcmp(value, keys[i]), 0);
+        }
+
+        /* assert - old bucket array has been drained */
+        EXPECT_TRUE(dict->old_buckets == NULL);
+        EXPECT_EQ(dict->old_capacity, 0);
+        EXPECT_TRUE(strukts_hashmap_get(dict, "missing") == NULL);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_KEEP_KEY_HASH_AND_LENGTH_IN_ENTRIES)
+    {
+        /* arrange */
+        StruktsHashmap* dict = strukts_hashmap_new();
+        uint32_t hash = strukts_murmur3_hash((const uint8_t*)"key", 3, 0);
+
+        /* act */
+        strukts_hashmap_add(dict, "key", (char*)"v1");
+        strukts_hashmap_add(dict, "key2", (char*)"v2");
+        strukts_hashmap_add(dict, "key", (char*)"v3"); /* shadows v1 */
+
+        /* assert - entries keep the key's murmur3 hash and length */
+        StruktsHashmapEntry* entry = dict->buckets[hash % dict->capacity];
+
+        while (entry != NULL && strcmp(entry->key, "key") != 0)
+            entry = entry->next;
+
+        ASSERT_TRUE(entry != NULL);
+        EXPECT_EQ(entry->hash, hash);
+        EXPECT_EQ(entry->key_len, 3);
+
+        /* assert - keys with a common prefix aren't mixed up and newest values come first */
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "key"), "v3"), 0);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "key2"), "v2"), 0);
+        EXPECT_TRUE(strukts_hashmap_get(dict, "ke") == NULL);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_ALLOCATE_ENTRIES_FROM_ARENA_SLABS)
+    {
+        /* arrange */
+        char keys[100][16];
+        unsigned int flags = STRUKTS_HASHMAP_ARENA | STRUKTS_HASHMAP_INCREMENTAL_REHASH;
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(flags);
+
+        /* act */
+        for (int i = 0; i < 100; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+            strukts_hashmap_add(dict, keys[i], keys[i]);
+        }
+
+        /* assert - all entries fit in the arena's first slab */
+        ASSERT_TRUE(dict->arena != NULL);
+        EXPECT_EQ(dict->arena->slabs_amount, 1);
+        EXPECT_EQ(dict->size, 100);
+
+        for (int i = 0; i < 100; i++)
+            EXPECT_EQ(strcmp(strukts_hashmap_get(dict, keys[i]), keys[i]), 0);
+
+        strukts_hashmap_free(dict); /* entries are released with the arena's slabs */
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_UPSERT_VALUES_OF_EXISTING_KEYS_IN_PLACE)
+    {
+        /* arrange */
+        StruktsHashmap* dict = strukts_hashmap_new();
+
+        /* act */
+        strukts_hashmap_upsert(dict, "k1", (char*)"v1");
+        strukts_hashmap_upsert(dict, "k2", (char*)"v2");
+        strukts_hashmap_upsert(dict, "k1", (char*)"v3");
+
+        /* assert - no duplicate entries: size keeps the amount of distinct keys */
+        EXPECT_EQ(dict->size, 2);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "k1"), "v3"), 0);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "k2"), "v2"), 0);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_REMOVE_KEYS_FROM_HASHMAP)
+    {
+        /* arrange */
+        StruktsHashmap* dict = strukts_hashmap_new();
+
+        strukts_hashmap_add(dict, "k1", (char*)"v1");
+        strukts_hashmap_add(dict, "k2", (char*)"v2");
+        strukts_hashmap_add(dict, "k3", (char*)"v3");
+
+        /* act */
+        bool removed = strukts_hashmap_remove(dict, "k2");
+        bool removed_twice = strukts_hashmap_remove(dict, "k2");
+
+        /* assert */
+        EXPECT_TRUE(removed);
+        EXPECT_FALSE(removed_twice);
+        EXPECT_EQ(dict->size, 2);
+        EXPECT_TRUE(strukts_hashmap_get(dict, "k2") == NULL);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "k1"), "v1"), 0);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "k3"), "v3"), 0);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_SHRINK_HASHMAP_ON_LOW_LOAD_FACTOR_WITH_KEY_CHURN)
+    {
+        /* arrange */
+        char keys[100][16];
+        StruktsHashmap* dict =
+            strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_SHRINK | STRUKTS_HASHMAP_ARENA);
+
+        for (int i = 0; i < 100; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+            strukts_hashmap_upsert(dict, keys[i], keys[i]);
+        }
+
+        /* assert - 100 keys need 256 buckets */
+        EXPECT_EQ(dict->capacity, 256);
+
+        /* act - removes all keys but 5 */
+        for (int i = 5; i < 100; i++)
+            EXPECT_TRUE(strukts_hashmap_remove(dict, keys[i]));
+
+        /* assert - halved whenever load factor dropped below 0.1: 256 -> 128 -> 64 -> 32 */
+        EXPECT_EQ(dict->size, 5);
+        EXPECT_EQ(dict->capacity, 32);
+
+        for (int i = 0; i < 5; i++)
+            EXPECT_EQ(strcmp(strukts_hashmap_get(dict, keys[i]), keys[i]), 0);
+
+        /* act - key churn recycles released entries instead of allocating new slabs */
+        for (int round = 0; round < 10; round++) {
+            for (int i = 5; i < 100; i++)
+                strukts_hashmap_upsert(dict, keys[i], keys[i]);
+            for (int i = 5; i < 100; i++)
+                strukts_hashmap_remove(dict, keys[i]);
+        }
+
+        /* assert */
+        EXPECT_EQ(dict->size, 5);
+        EXPECT_EQ(dict->arena->slabs_amount, 1);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_GET_MANY_KEYS_AT_ONCE_WHILE_REHASHING_INCREMENTALLY)
+    {
+        /* arrange */
+        char keys[100][16];
+        const char* searched_keys[101];
+        char* values[101];
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_INCREMENTAL_REHASH);
+
+        for (int i = 0; i < 100; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+            strukts_hashmap_add(dict, keys[i], keys[i]);
+            searched_keys[i] = keys[i];
+        }
+
+        searched_keys[100] = "missing";
+
+        /* act - more keys than a single batch (some still in the old bucket array) */
+        size_t found = strukts_hashmap_get_many(dict, searched_keys, 101, values);
+
+        /* assert */
+        EXPECT_EQ(found, 100);
+        EXPECT_TRUE(values[100] == NULL);
+
+        for (int i = 0; i < 100; i++) {
+            ASSERT_TRUE(values[i] != NULL);
+            EXPECT_EQ(strcmp(values[i], keys[i]), 0);
+        }
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_USE_BINARY_KEYS_AND_BUFFER_SLICES_AS_KEYS)
+    {
+        /* arrange - binary keys with zero bytes and slices of a bigger buffer */
+        const uint8_t id1[4] = {0x00, 0x01, 0x00, 0x02};
+        const uint8_t id2[4] = {0x00, 0x01, 0x00, 0x03};
+        const char buffer[] = "GET /users HTTP/1.1";
+        StruktsHashmap* dict = strukts_hashmap_new();
+
+        /* act */
+        strukts_hashmap_add_n(dict, id1, sizeof(id1), (char*)"user1");
+        strukts_hashmap_add_n(dict, id2, sizeof(id2), (char*)"user2");
+        strukts_hashmap_upsert_n(dict, buffer + 4, 6, (char*)"users"); /* "/users" */
+
+        /* assert */
+        EXPECT_EQ(dict->size, 3);
+        EXPECT_EQ(strcmp(strukts_hashmap_get_n(dict, id1, sizeof(id1)), "user1"), 0);
+        EXPECT_EQ(strcmp(strukts_hashmap_get_n(dict, id2, sizeof(id2)), "user2"), 0);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "/users"), "users"), 0);
+        EXPECT_TRUE(strukts_hashmap_get_n(dict, id1, 2) == NULL); /* prefix of id1 and id2 */
+
+        /* act */
+        bool removed = strukts_hashmap_remove_n(dict, id1, sizeof(id1));
+
+        /* assert */
+        EXPECT_TRUE(removed);
+        EXPECT_EQ(dict->size, 2);
+        EXPECT_TRUE(strukts_hashmap_get_n(dict, id1, sizeof(id1)) == NULL);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_PRESIZE_HASHMAP_TO_AVOID_REHASHING)
+    {
+        /* arrange & act - 1000 keys need 2048 buckets to stay below the 0.7 load factor */
+        static char keys[1000][16];
+        StruktsHashmap* dict = strukts_hashmap_new_with_capacity(1000);
+        StruktsHashmap* reserved = strukts_hashmap_new();
+
+        strukts_hashmap_add(reserved, "first", (char*)"first");
+        bool reserved_ok = strukts_hashmap_reserve(reserved, 1000);
+
+        /* assert */
+        EXPECT_EQ(dict->capacity, 2048);
+        EXPECT_TRUE(reserved_ok);
+        EXPECT_EQ(reserved->capacity, 2048);
+        EXPECT_EQ(strcmp(strukts_hashmap_get(reserved, "first"), "first"), 0);
+
+        /* act - adding the expected keys never rehashes */
+        for (int i = 0; i < 1000; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key-%d", i);
+            strukts_hashmap_add(dict, keys[i], keys[i]);
+        }
+
+        /* assert - reserving less than the current capacity never shrinks it */
+        EXPECT_EQ(dict->capacity, 2048);
+        EXPECT_TRUE(strukts_hashmap_reserve(dict, 10));
+        EXPECT_EQ(dict->capacity, 2048);
+
+        strukts_hashmap_free(dict);
+        strukts_hashmap_free(reserved);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_BUILD_HASHMAP_FROM_KEYS_AND_VALUES_WITH_THREADS)
+    {
+        /* arrange */
+        const size_t keys_amount = 5000;
+        static char keys[5000][16];
+        static char* values[5000];
+
+        for (size_t i = 0; i < keys_amount; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key-%zu", i);
+            values[i] = keys[i];
+        }
+
+        const char* key_pointers[5000];
+
+        for (size_t i = 0; i < keys_amount; i++)
+            key_pointers[i] = keys[i];
+
+        /* act */
+        StruktsHashmap* single = strukts_hashmap_build(key_pointers, values, keys_amount, 1);
+        StruktsHashmap* threaded = strukts_hashmap_build(key_pointers, values, keys_amount, 4);
+
+        /* assert */
+        EXPECT_EQ(single->size, keys_amount);
+        EXPECT_EQ(threaded->size, keys_amount);
+        EXPECT_EQ(threaded->capacity, 8192);
+
+        for (size_t i = 0; i < keys_amount; i++) {
+            EXPECT_EQ(strukts_hashmap_get(single, keys[i]), keys[i]);
+            EXPECT_EQ(strukts_hashmap_get(threaded, keys[i]), keys[i]);
+        }
+
+        strukts_hashmap_free(single);
+        strukts_hashmap_free(threaded);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_COPY_OWNED_KEYS_INLINE_OR_INTO_OWN_ALLOCATIONS)
+    {
+        /* arrange - keys are built in a buffer which is overwritten after each addition */
+        const char* long_key = "https://strukts.io/a/rather/long/path/used/as/key";
+        unsigned int flags_list[2] = {STRUKTS_HASHMAP_OWN_KEYS,
+                                      STRUKTS_HASHMAP_OWN_KEYS | STRUKTS_HASHMAP_ARENA};
+        char buffer[64];
+
+        for (size_t f = 0; f < 2; f++) {
+            StruktsHashmap* dict = strukts_hashmap_new_with_flags(flags_list[f]);
+
+            /* act */
+            for (int i = 0; i < 100; i++) {
+                snprintf(buffer, sizeof(buffer), "key-%d", i);
+                strukts_hashmap_add(dict, buffer, (char*)"short");
+            }
+
+            snprintf(buffer, sizeof(buffer), "%s", long_key);
+            strukts_hashmap_add(dict, buffer, (char*)"long");
+            memset(buffer, 0, sizeof(buffer));
+
+            /* assert */
+            EXPECT_EQ(dict->size, 101);
+            EXPECT_EQ(strcmp(strukts_hashmap_get(dict, "key-42"), "short"), 0);
+            EXPECT_EQ(strcmp(strukts_hashmap_get(dict, long_key), "long"), 0);
+
+            /* short keys are right after their entries: a 64-byte entry on 64-bit platforms */
+            uint32_t hash = strukts_murmur3_hash((const uint8_t*)"key-42", 6, 0);
+            StruktsHashmapEntry* entry = dict->buckets[hash % dict->capacity];
+
+            while (strcmp(entry->key, "key-42") != 0)
+                entry = entry->next;
+
+            EXPECT_EQ(entry->key, (const char*)(entry + 1));
+            EXPECT_EQ((uintptr_t)entry % STRUKTS_ARENA_CACHE_LINE, 0);
+            EXPECT_EQ(dict->key_bytes, strlen(long_key) + 1);
+
+            if (sizeof(void*) == 8) {
+                EXPECT_EQ(sizeof(StruktsHashmapEntry) + STRUKTS_HASHMAP_INLINE_KEY_SIZE, 64);
+            }
+
+            /* act & assert - removals */
+            EXPECT_TRUE(strukts_hashmap_remove(dict, long_key));
+            EXPECT_TRUE(strukts_hashmap_remove(dict, "key-0"));
+            EXPECT_TRUE(strukts_hashmap_get(dict, long_key) == NULL);
+            EXPECT_EQ(dict->key_bytes, 0);
+
+            strukts_hashmap_free(dict);
+        }
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_KEEP_MEMORY_BOUNDED_WHEN_OWNED_KEYS_ARE_CHURNED)
+    {
+        /* arrange - long keys that can't be stored inline */
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_OWN_KEYS);
+        char buffer[64];
+        size_t first_round_bytes = 0;
+
+        /* act - adds and removes a different set of keys on every round */
+        for (int round = 0; round < 50; round++) {
+            for (int i = 0; i < 200; i++) {
+                snprintf(buffer, sizeof(buffer), "https://strukts.io/churn/%03d/%d", round, i);
+                strukts_hashmap_add(dict, buffer, (char*)"value");
+            }
+
+            if (round == 0)
+                first_round_bytes = strukts_hashmap_stats(dict).allocated_bytes;
+
+            for (int i = 0; i < 200; i++) {
+                snprintf(buffer, sizeof(buffer), "https://strukts.io/churn/%03d/%d", round, i);
+                EXPECT_TRUE(strukts_hashmap_remove(dict, buffer));
+            }
+        }
+
+        /* assert - removed keys (and their entries) are reclaimed */
+        EXPECT_EQ(dict->size, 0);
+        EXPECT_EQ(dict->key_bytes, 0);
+
+        for (int i = 0; i < 200; i++) {
+            snprintf(buffer, sizeof(buffer), "https://strukts.io/churn/%03d/%d", 50, i);
+            strukts_hashmap_add(dict, buffer, (char*)"value");
+        }
+
+        EXPECT_LE(strukts_hashmap_stats(dict).allocated_bytes, first_round_bytes);
+
+        strukts_hashmap_free(dict);
+    }
+
+    void count_scanned_key(const StruktsHashmapEntry* entry, void* context)
+    {
+        std::map<std::string, int>* visits = (std::map<std::string, int>*)context;
+
+        (*visits)[std::string(entry->key, entry->key_len)]++;
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_ITERATE_OVER_ALL_ENTRIES_IN_BUCKET_ORDER)
+    {
+        /* arrange - an incremental rehashing is left in progress */
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_INCREMENTAL_REHASH);
+        std::vector<std::string> keys;
+        std::map<std::string, int> visits;
+        StruktsHashmapIterator iterator;
+
+        for (int i = 0; i < 200; i++)
+            keys.push_back("key-" + std::to_string(i));
+
+        for (size_t i = 0; i < keys.size(); i++)
+            strukts_hashmap_add(dict, keys[i].c_str(), (char*)keys[i].c_str());
+
+        EXPECT_TRUE(dict->old_buckets != NULL);
+
+        /* act */
+        strukts_hashmap_iterator_init(&iterator, dict);
+
+        for (const StruktsHashmapEntry* entry = strukts_hashmap_iterator_next(&iterator);
+             entry != NULL; entry = strukts_hashmap_iterator_next(&iterator)) {
+            EXPECT_EQ(strcmp(entry->key, entry->value), 0);
+            visits[entry->key]++;
+        }
+
+        /* assert - every key exactly once and the iterator stays exhausted */
+        EXPECT_EQ(visits.size(), keys.size());
+
+        for (size_t i = 0; i < keys.size(); i++)
+            EXPECT_EQ(visits[keys[i]], 1);
+
+        EXPECT_TRUE(strukts_hashmap_iterator_next(&iterator) == NULL);
+
+        /* empty hash maps have nothing to iterate over */
+        StruktsHashmap* empty = strukts_hashmap_new();
+
+        strukts_hashmap_iterator_init(&iterator, empty);
+        EXPECT_TRUE(strukts_hashmap_iterator_next(&iterator) == NULL);
+
+        strukts_hashmap_free(dict);
+        strukts_hashmap_free(empty);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_SCAN_ALL_KEYS_WITH_CURSOR_ACROSS_RESIZES)
+    {
+        /* arrange */
+        unsigned int flags_list[2] = {STRUKTS_HASHMAP_SHRINK,
+                                      STRUKTS_HASHMAP_SHRINK | STRUKTS_HASHMAP_INCREMENTAL_REHASH};
+        std::vector<std::string> stable_keys;
+        std::vector<std::string> extra_keys;
+
+        for (int i = 0; i < 20; i++)
+            stable_keys.push_back("stable-" + std::to_string(i));
+
+        for (int i = 0; i < 400; i++)
+            extra_keys.push_back("extra-" + std::to_string(i));
+
+        for (size_t f = 0; f < 2; f++) {
+            StruktsHashmap* dict = strukts_hashmap_new_with_flags(flags_list[f]);
+            std::map<std::string, int> visits;
+            uint64_t cursor = 0;
+            size_t calls = 0;
+
+            for (size_t i = 0; i < stable_keys.size(); i++)
+                strukts_hashmap_add(dict, stable_keys[i].c_str(), NULL);
+
+            /* act - the hash map grows (then shrinks back) while it's being scanned */
+            do {
+                cursor = strukts_hashmap_scan(dict, cursor, count_scanned_key, &visits);
+
+                if (calls < extra_keys.size())
+                    strukts_hashmap_add(dict, extra_keys[calls].c_str(), NULL);
+                else if (calls < 2 * extra_keys.size())
+                    strukts_hashmap_remove(dict, extra_keys[calls - extra_keys.size()].c_str());
+
+                calls++;
+            } while (cursor != 0);
+
+            /* assert - keys which were always in the hash map are visited at least once */
+            for (size_t i = 0; i < stable_keys.size(); i++)
+                EXPECT_GE(visits[stable_keys[i]], 1);
+
+            strukts_hashmap_free(dict);
+        }
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_KEEP_HASHMAP_POINTER_STABLE_WHEN_RESIZING)
+    {
+        /* arrange - another structure holds a copy of the hash map pointer */
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_SHRINK);
+        StruktsHashmap* const shared = dict;
+        StruktsHashmapEntry** initial_buckets = dict->buckets;
+        std::vector<std::string> keys;
+
+        for (int i = 0; i < 100; i++)
+            keys.push_back("key-" + std::to_string(i));
+
+        /* act - the hash map grows and then shrinks back */
+        for (size_t i = 0; i < keys.size(); i++)
+            strukts_hashmap_add(dict, keys[i].c_str(), (char*)keys[i].c_str());
+
+        /* assert - only the inner bucket array has been swapped */
+        EXPECT_EQ(dict, shared);
+        EXPECT_NE(shared->buckets, initial_buckets);
+        EXPECT_EQ(shared->size, 100);
+        EXPECT_EQ(strukts_hashmap_get(shared, "key-99"), keys[99].c_str());
+
+        size_t grown_capacity = shared->capacity;
+
+        for (size_t i = 1; i < keys.size(); i++)
+            strukts_hashmap_remove(shared, keys[i].c_str());
+
+        EXPECT_EQ(dict, shared);
+        EXPECT_LT(dict->capacity, grown_capacity);
+        EXPECT_EQ(strukts_hashmap_get(dict, "key-0"), keys[0].c_str());
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_REPORT_OCCUPANCY_AND_CHAIN_LENGTH_STATS)
+    {
+        /* arrange */
+        StruktsHashmap* dict = strukts_hashmap_new();
+        std::vector<std::string> keys;
+
+        for (int i = 0; i < 1000; i++)
+            keys.push_back("key-" + std::to_string(i));
+
+        /* act - a single key in a single bucket (DEBUG: initial capacity of 1) */
+        strukts_hashmap_add(dict, keys[0].c_str(), NULL);
+        StruktsHashmapStats stats = strukts_hashmap_stats(dict);
+
+        /* assert */
+        EXPECT_EQ(stats.size, 1);
+        EXPECT_EQ(stats.capacity, STRUKTS_HASHMAP_INITIAL_CAPACITY);
+        EXPECT_EQ(stats.longest_chain, 1);
+        EXPECT_EQ(stats.chain_lengths[1], 1);
+        EXPECT_EQ(stats.empty_buckets, STRUKTS_HASHMAP_INITIAL_CAPACITY - 1);
+        EXPECT_EQ(stats.rehashes, 0);
+
+        /* act - many keys: the hash map grows a few times */
+        for (size_t i = 1; i < keys.size(); i++)
+            strukts_hashmap_add(dict, keys[i].c_str(), NULL);
+
+        stats = strukts_hashmap_stats(dict);
+
+        /* assert - the histogram accounts for every bucket and (short chains) every key */
+        size_t buckets = 0;
+        size_t entries = 0;
+
+        for (size_t i = 0; i < STRUKTS_HASHMAP_STATS_CHAINS; i++) {
+            buckets += stats.chain_lengths[i];
+            entries += i * stats.chain_lengths[i];
+        }
+
+        EXPECT_EQ(stats.size, 1000);
+        EXPECT_EQ(stats.capacity, dict->capacity);
+        EXPECT_EQ(buckets, stats.capacity);
+        EXPECT_DOUBLE_EQ(stats.load_factor, 1000.0 / (double)dict->capacity);
+        EXPECT_EQ(stats.empty_buckets, stats.chain_lengths[0]);
+        EXPECT_GE(stats.longest_chain, 1);
+        EXPECT_GT(stats.rehashes, 0);
+        EXPECT_GT(stats.rehash_ns, 0);
+        EXPECT_GE(stats.allocated_bytes, 1000 * sizeof(StruktsHashmapEntry) +
+                                             dict->capacity * sizeof(StruktsHashmapEntry*));
+
+        if (stats.longest_chain < STRUKTS_HASHMAP_STATS_CHAINS) {
+            EXPECT_EQ(entries, 1000);
+        }
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_COUNT_LOOKUPS_ONLY_WITH_OP_COUNTERS)
+    {
+        /* arrange */
+        StruktsHashmap* dict = strukts_hashmap_new();
+        const char* keys[3] = {"k1", "k2", "missing"};
+        char* values[3];
+
+        strukts_hashmap_add(dict, "k1", (char*)"v1");
+        strukts_hashmap_add(dict, "k2", (char*)"v2");
+
+        /* act */
+        strukts_hashmap_get(dict, "k1");
+        strukts_hashmap_get(dict, "missing");
+        strukts_hashmap_get_many(dict, keys, 3, values);
+
+        StruktsHashmapStats stats = strukts_hashmap_stats(dict);
+
+        /* assert */
+#ifdef STRUKTS_HASHMAP_OP_COUNTERS
+        EXPECT_EQ(stats.op_counters.gets, 5);
+        EXPECT_EQ(stats.op_counters.hits, 3);
+        EXPECT_EQ(stats.op_counters.misses, 2);
+        EXPECT_GE(stats.op_counters.comparisons, 3);
+#else
+        EXPECT_EQ(stats.op_counters.gets, 0);
+        EXPECT_EQ(stats.op_counters.hits, 0);
+        EXPECT_EQ(stats.op_counters.misses, 0);
+        EXPECT_EQ(stats.op_counters.comparisons, 0);
+#endif
+
+        strukts_hashmap_free(dict);
+    }
+
+    size_t chain_length(const StruktsHashmapEntry* entry)
+    {
+        size_t length = 0;
+
+        for (; entry != NULL; entry = entry->next)
+            length++;
+
+        return length;
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_WALK_CHAINS_ONCE_PER_MISS_OF_BATCHED_LOOKUPS_WHILE_REHASHING)
+    {
+        /* arrange - an incremental rehashing is left in progress */
+        StruktsHashmap* dict = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_INCREMENTAL_REHASH);
+        std::vector<std::string> keys;
+        std::vector<const char*> missing_keys;
+        std::vector<char*> values(100);
+
+        for (int i = 0; i < 200; i++)
+            keys.push_back("key-" + std::to_string(i));
+
+        for (int i = 0; i < 100; i++)
+            keys.push_back("missing-" + std::to_string(i));
+
+        for (size_t i = 0; i < 200; i++)
+            strukts_hashmap_add(dict, keys[i].c_str(), (char*)keys[i].c_str());
+
+        for (size_t i = 200; i < keys.size(); i++)
+            missing_keys.push_back(keys[i].c_str());
+
+        /* act */
+        size_t found =
+            strukts_hashmap_get_many(dict, missing_keys.data(), missing_keys.size(), values.data());
+
+        /* assert - every miss walks its new chain and, if not migrated yet, its old chain once */
+        size_t expected_comparisons = 0;
+
+        ASSERT_TRUE(dict->old_buckets != NULL);
+
+        for (size_t i = 0; i < missing_keys.size(); i++) {
+            uint32_t hash =
+                strukts_murmur3_hash((const uint8_t*)missing_keys[i], strlen(missing_keys[i]), 0);
+            size_t old_bucket_hash = hash % dict->old_capacity;
+
+            expected_comparisons += chain_length(dict->buckets[hash % dict->capacity]);
+
+            if (old_bucket_hash >= dict->rehash_index)
+                expected_comparisons += chain_length(dict->old_buckets[old_bucket_hash]);
+
+            EXPECT_TRUE(values[i] == NULL);
+        }
+
+        EXPECT_EQ(found, 0);
+#ifdef STRUKTS_HASHMAP_OP_COUNTERS
+        EXPECT_EQ(strukts_hashmap_stats(dict).op_counters.comparisons, expected_comparisons);
+#endif
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_FIND_KEYS_BEHIND_ATTACHED_BLOOM_FILTER)
+    {
+        /* arrange */
+        StruktsHashmap* dict = strukts_hashmap_new();
+        std::vector<std::string> keys;
+        std::vector<const char*> key_pointers;
+        std::vector<char*> values(2000);
+
+        for (int i = 0; i < 2000; i++)
+            keys.push_back("key-" + std::to_string(i));
+
+        for (int i = 0; i < 1000; i++)
+            strukts_hashmap_add(dict, keys[i].c_str(), (char*)"before");
+
+        /* act - keys added before and after attaching the filter */
+        bool attached = strukts_hashmap_attach_bloom_filter(dict, 2000, 0.01,
+                                                            STRUKTS_BLOOM_FILTER_BLOCKED);
+
+        for (int i = 1000; i < 2000; i++)
+            strukts_hashmap_add(dict, keys[i].c_str(), (char*)"after");
+
+        for (int i = 0; i < 2000; i++)
+            key_pointers.push_back(keys[i].c_str());
+
+        strukts_hashmap_get_many(dict, key_pointers.data(), key_pointers.size(), values.data());
+
+        /* assert */
+        ASSERT_TRUE(attached);
+        ASSERT_TRUE(dict->bloom_filter != NULL);
+        EXPECT_EQ(dict->bloom_filter->keys_amount, 2000);
+
+        for (int i = 0; i < 2000; i++) {
+            const char* expected = i < 1000 ? "before" : "after";
+
+            EXPECT_STREQ(strukts_hashmap_get(dict, keys[i].c_str()), expected);
+            EXPECT_STREQ(values[i], expected);
+        }
+
+        /* most missing keys are rejected by the filter and all of them are missing */
+        int rejected = 0;
+
+        for (int i = 0; i < 10000; i++) {
+            std::string missing_key = "missing-" + std::to_string(i);
+
+            rejected += !strukts_bloom_filter_might_contain(dict->bloom_filter,
+                                                            missing_key.c_str());
+            EXPECT_TRUE(strukts_hashmap_get(dict, missing_key.c_str()) == NULL);
+        }
+
+        EXPECT_GT(rejected, 9500);
+
+        strukts_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_HASHMAP_SUITE, SHOULD_FIND_KEYS_HASHED_BY_128BIT_MURMUR3)
+    {
+        /* arrange */
+        StruktsHashmap* dict =
+            strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_MURMUR3_128 | STRUKTS_HASHMAP_OWN_KEYS);
+        std::string long_key(1000, 'k');
+        uint64_t long_key_hash[2];
+
+        strukts_murmur3_hash_x64_128((const uint8_t*)long_key.data(), long_key.size(), 0,
+                                     long_key_hash);
+
+        /* act */
+        for (int i = 0; i < 1000; i++)
+            strukts_hashmap_add(dict, ("key-" + std::to_string(i)).c_str(), (char*)"value");
+
+        strukts_hashmap_add(dict, long_key.c_str(), (char*)"long");
+        bool attached = strukts_hashmap_attach_bloom_filter(dict, 2000, 0.01,
+                                                            STRUKTS_BLOOM_FILTER_DEFAULT);
+
+        /* assert - the filter hashes keys just like the hash map */
+        ASSERT_TRUE(attached);
+        EXPECT_TRUE(dict->bloom_filter->flags & STRUKTS_BLOOM_FILTER_MURMUR3_128);
+        EXPECT_TRUE(strukts_bloom_filter_might_contain(dict->bloom_filter, long_key.c_str()));
+        EXPECT_STREQ(strukts_hashmap_get(dict, long_key.c_str()), "long");
+        EXPECT_TRUE(strukts_hashmap_get(dict, "missing") == NULL);
+
+        for (int i = 0; i < 1000; i++)
+            EXPECT_STREQ(strukts_hashmap_get(dict, ("key-" + std::to_string(i)).c_str()), "value");
+
+        /* entries keep the lower 32 bits of the 128-bit hash */
+        StruktsHashmapIterator iterator;
+        const StruktsHashmapEntry* entry;
+
+        strukts_hashmap_iterator_init(&iterator, dict);
+
+        while ((entry = strukts_hashmap_iterator_next(&iterator)) != NULL) {
+            if (entry->key_len == long_key.size()) {
+                EXPECT_EQ(entry->hash, (uint32_t)long_key_hash[0]);
+            }
+        }
+
+        strukts_hashmap_free(dict);
+    }
 }  // namespace
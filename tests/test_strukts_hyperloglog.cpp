@@ -0,0 +1,103 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_hyperloglog.h"
+
+namespace
+{
+    TEST(STRUKTS_HYPERLOGLOG_SUITE, SHOULD_COUNT_SMALL_SETS_WITH_SPARSE_REGISTERS)
+    {
+        /* arrange */
+        StruktsHyperLogLog* hll = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION);
+
+        ASSERT_TRUE(hll != NULL);
+        EXPECT_EQ(strukts_hyperloglog_count(hll), 0);
+
+        /* act - every key is added three times */
+        for (int round = 0; round < 3; round++)
+            for (int i = 0; i < 100; i++)
+                strukts_hyperloglog_add(hll, ("key-" + std::to_string(i)).c_str());
+
+        /* assert */
+        EXPECT_TRUE(hll->sparse);
+        EXPECT_TRUE(hll->registers == NULL);
+        EXPECT_NEAR((double)strukts_hyperloglog_count(hll), 100, 3);
+
+        /* sparse registers are sorted by their indexes */
+        for (size_t i = 1; i < hll->sparse_amount; i++)
+            EXPECT_LT(hll->sparse_registers[i - 1] >> 8, hll->sparse_registers[i] >> 8);
+
+        strukts_hyperloglog_free(hll);
+    }
+
+    TEST(STRUKTS_HYPERLOGLOG_SUITE, SHOULD_ESTIMATE_LARGE_SETS_WITH_DENSE_REGISTERS)
+    {
+        /* arrange */
+        StruktsHyperLogLog* hll = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION);
+        std::vector<std::string> keys;
+        std::vector<const char*> key_pointers;
+
+        for (int i = 0; i < 100000; i++)
+            keys.push_back("key-" + std::to_string(i));
+
+        for (size_t i = 0; i < keys.size(); i++)
+            key_pointers.push_back(keys[i].c_str());
+
+        /* act */
+        bool added = strukts_hyperloglog_add_many(hll, key_pointers.data(), key_pointers.size());
+
+        /* assert: ~1.6% standard error, so 5% is beyond 3 standard errors */
+        EXPECT_TRUE(added);
+        EXPECT_FALSE(hll->sparse);
+        EXPECT_TRUE(hll->sparse_registers == NULL);
+        EXPECT_NEAR((double)strukts_hyperloglog_count(hll), 100000, 5000);
+
+        strukts_hyperloglog_free(hll);
+    }
+
+    TEST(STRUKTS_HYPERLOGLOG_SUITE, SHOULD_ESTIMATE_UNION_WHEN_MERGING)
+    {
+        /* arrange - dense and sparse sketches with overlapping keys */
+        StruktsHyperLogLog* dense = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION);
+        StruktsHyperLogLog* sparse = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION);
+        StruktsHyperLogLog* empty = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_DEFAULT_PRECISION);
+        StruktsHyperLogLog* other = strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_MIN_PRECISION);
+
+        for (int i = 0; i < 50000; i++)
+            strukts_hyperloglog_add(dense, ("key-" + std::to_string(i)).c_str());
+
+        for (int i = 49900; i < 50100; i++)
+            strukts_hyperloglog_add(sparse, ("key-" + std::to_string(i)).c_str());
+
+        /* act */
+        bool merged_sparse = strukts_hyperloglog_merge(empty, sparse);
+        bool merged_dense = strukts_hyperloglog_merge(empty, dense);
+        bool merged_other = strukts_hyperloglog_merge(empty, other);
+
+        /* assert */
+        EXPECT_TRUE(merged_sparse);
+        EXPECT_TRUE(merged_dense);
+        EXPECT_FALSE(merged_other);
+        EXPECT_TRUE(sparse->sparse);
+        EXPECT_FALSE(empty->sparse);
+        EXPECT_NEAR((double)strukts_hyperloglog_count(empty), 50100, 2500);
+
+        strukts_hyperloglog_free(dense);
+        strukts_hyperloglog_free(sparse);
+        strukts_hyperloglog_free(empty);
+        strukts_hyperloglog_free(other);
+    }
+
+    TEST(STRUKTS_HYPERLOGLOG_SUITE, SHOULD_NOT_CREATE_HYPERLOGLOG_WITH_INVALID_PRECISION)
+    {
+        /* act & assert */
+        EXPECT_TRUE(strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_MIN_PRECISION - 1) == NULL);
+        EXPECT_TRUE(strukts_hyperloglog_new(STRUKTS_HYPERLOGLOG_MAX_PRECISION + 1) == NULL);
+    }
+}  // namespace
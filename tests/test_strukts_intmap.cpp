@@ -0,0 +1,86 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+#include "strukts_intmap.h"
+
+namespace
+{
+    TEST(STRUKTS_INTMAP_SUITE, SHOULD_UPSERT_AND_GET_INTEGER_KEYS_WITH_RESIZING)
+    {
+        /* arrange */
+        const uint64_t keys_amount = 10000;
+        static char values[10000];
+        StruktsIntmap* intmap = strukts_intmap_new();
+
+        /* act - sequential ids plus ids that only differ in their high bits */
+        for (uint64_t i = 1; i < keys_amount; i++)
+            strukts_intmap_upsert(intmap, i, &values[i]);
+
+        strukts_intmap_upsert(intmap, 1ull << 40, &values[0]);
+        strukts_intmap_upsert(intmap, 0, &values[0]);
+
+        /* assert */
+        EXPECT_EQ(intmap->size, keys_amount + 1);
+        EXPECT_EQ(intmap->capacity, 16384);
+
+        for (uint64_t i = 1; i < keys_amount; i++)
+            EXPECT_EQ(strukts_intmap_get(intmap, i), &values[i]);
+
+        EXPECT_EQ(strukts_intmap_get(intmap, 1ull << 40), &values[0]);
+        EXPECT_EQ(strukts_intmap_get(intmap, 0), &values[0]);
+        EXPECT_TRUE(strukts_intmap_get(intmap, keys_amount) == NULL);
+        EXPECT_TRUE(strukts_intmap_contains(intmap, 0));
+        EXPECT_FALSE(strukts_intmap_contains(intmap, UINT64_MAX));
+
+        /* act & assert - replacements */
+        EXPECT_TRUE(strukts_intmap_upsert(intmap, 42, &values[1]));
+        EXPECT_EQ(strukts_intmap_get(intmap, 42), &values[1]);
+        EXPECT_EQ(intmap->size, keys_amount + 1);
+
+        strukts_intmap_free(intmap);
+    }
+
+    TEST(STRUKTS_INTMAP_SUITE, SHOULD_REMOVE_INTEGER_KEYS_WITHOUT_TOMBSTONES)
+    {
+        /* arrange */
+        const uint64_t keys_amount = 2000;
+        static char values[2000];
+        StruktsIntmap* intmap = strukts_intmap_new();
+
+        for (uint64_t i = 0; i < keys_amount; i++)
+            strukts_intmap_upsert(intmap, i, &values[i]);
+
+        /* act - removes every odd key (and the key 0) */
+        for (uint64_t i = 1; i < keys_amount; i += 2)
+            EXPECT_TRUE(strukts_intmap_remove(intmap, i));
+
+        EXPECT_TRUE(strukts_intmap_remove(intmap, 0));
+
+        /* assert */
+        EXPECT_EQ(intmap->size, keys_amount / 2 - 1);
+        EXPECT_FALSE(strukts_intmap_remove(intmap, 1));
+        EXPECT_FALSE(strukts_intmap_remove(intmap, 0));
+        EXPECT_FALSE(strukts_intmap_contains(intmap, 0));
+
+        for (uint64_t i = 1; i < keys_amount; i++) {
+            char* expected = i % 2 == 0 ? &values[i] : NULL;
+            EXPECT_EQ(strukts_intmap_get(intmap, i), expected);
+        }
+
+        /* act - removes the remaining keys */
+        for (uint64_t i = 2; i < keys_amount; i += 2)
+            strukts_intmap_remove(intmap, i);
+
+        /* assert - every slot is empty again */
+        size_t full_slots = 0;
+
+        for (size_t i = 0; i < intmap->capacity; i++)
+            full_slots += intmap->slots[i].key != 0;
+
+        EXPECT_EQ(intmap->size, 0);
+        EXPECT_EQ(full_slots, 0);
+
+        strukts_intmap_free(intmap);
+    }
+}  // namespace
@@ -154,4 +154,44 @@ namespace
 
         strukts_linkedlist_free(list);
     }
+
+    TEST(STRUKTS_LINKEDLISTS_SUITE, SHOULD_MOVE_AND_REMOVE_NODES_IN_CONSTANT_TIME)
+    {
+        /* arrange - create list ["1", "2", "3"] */
+        StruktsLinkedList* list = strukts_linkedlist_new();
+
+        strukts_linkedlist_append(list, "1", (char*)"1");
+        strukts_linkedlist_append(list, "2", (char*)"2");
+        strukts_linkedlist_append(list, "3", (char*)"3");
+
+        /* act - move the last node to the front -> ["3", "1", "2"] */
+        strukts_linkedlist_move_to_front(list, list->last_node);
+
+        /* assert */
+        EXPECT_EQ(list->size, 3);
+        EXPECT_EQ(strcmp(list->first_node->key, "3"), 0);
+        EXPECT_EQ(strcmp(list->first_node->next->key, "1"), 0);
+        EXPECT_EQ(strcmp(list->last_node->key, "2"), 0);
+        EXPECT_EQ(list->first_node->previous, nullptr);
+        EXPECT_EQ(list->last_node->next, nullptr);
+
+        /* act - remove the middle node -> ["3", "2"] */
+        strukts_linkedlist_remove_node(list, list->first_node->next);
+
+        /* assert */
+        EXPECT_EQ(list->size, 2);
+        EXPECT_EQ(list->first_node->next, list->last_node);
+        EXPECT_EQ(list->last_node->previous, list->first_node);
+
+        /* act - remove the remaining nodes -> [] */
+        strukts_linkedlist_remove_node(list, list->last_node);
+        strukts_linkedlist_remove_node(list, list->first_node);
+
+        /* assert */
+        EXPECT_EQ(list->size, 0);
+        EXPECT_EQ(list->first_node, nullptr);
+        EXPECT_EQ(list->last_node, nullptr);
+
+        strukts_linkedlist_free(list);
+    }
 }  // namespace
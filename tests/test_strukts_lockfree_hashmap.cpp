@@ -0,0 +1,102 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_lockfree_hashmap.h"
+
+namespace
+{
+    TEST(STRUKTS_LOCKFREE_HASHMAP_SUITE, SHOULD_UPSERT_GET_AND_REMOVE_KEYS)
+    {
+        /* arrange */
+        StruktsLockFreeHashmap* dict = strukts_lockfree_hashmap_new(1);
+        StruktsEpochReader* reader = strukts_lockfree_hashmap_reader_register(dict);
+        char key[16];
+        char value1[] = "value1";
+        char value2[] = "value2";
+
+        /* act - the key is copied, so the caller's buffer can be reused */
+        snprintf(key, sizeof(key), "key");
+        strukts_lockfree_hashmap_upsert(dict, key, value1);
+        snprintf(key, sizeof(key), "other");
+
+        /* assert */
+        EXPECT_EQ(strukts_lockfree_hashmap_get(dict, reader, "key"), value1);
+        EXPECT_TRUE(strukts_lockfree_hashmap_get(dict, reader, "other") == NULL);
+
+        /* act & assert - replacements publish new nodes */
+        EXPECT_TRUE(strukts_lockfree_hashmap_upsert(dict, "key", value2));
+        EXPECT_EQ(strukts_lockfree_hashmap_get(dict, reader, "key"), value2);
+        EXPECT_EQ(strukts_lockfree_hashmap_size(dict), 1);
+
+        EXPECT_TRUE(strukts_lockfree_hashmap_remove(dict, "key"));
+        EXPECT_FALSE(strukts_lockfree_hashmap_remove(dict, "key"));
+        EXPECT_TRUE(strukts_lockfree_hashmap_get(dict, reader, "key") == NULL);
+        EXPECT_EQ(strukts_lockfree_hashmap_size(dict), 0);
+        EXPECT_EQ(reader->state, 0);
+
+        strukts_lockfree_hashmap_reader_unregister(dict, reader);
+        strukts_lockfree_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_LOCKFREE_HASHMAP_SUITE, SHOULD_GET_KEYS_WHILE_WRITER_RESIZES)
+    {
+        /* arrange - a few stable keys which readers must always find */
+        const int readers_amount = 3;
+        const int keys_amount = 2000;
+        static char keys[2000][16];
+        StruktsLockFreeHashmap* dict = strukts_lockfree_hashmap_new(readers_amount);
+        std::vector<std::thread> readers;
+        bool all_found[3] = {true, true, true};
+        bool done = false;
+        size_t removed = 0;
+
+        for (int i = 0; i < keys_amount; i++)
+            snprintf(keys[i], sizeof(keys[i]), "key-%d", i);
+
+        for (int i = 0; i < 8; i++)
+            strukts_lockfree_hashmap_upsert(dict, keys[i], keys[i]);
+
+        /* act - readers look up the stable keys while the writer grows and churns the table */
+        for (int r = 0; r < readers_amount; r++) {
+            readers.push_back(std::thread([&, r]() {
+                StruktsEpochReader* reader = strukts_lockfree_hashmap_reader_register(dict);
+
+                while (!__atomic_load_n(&done, __ATOMIC_ACQUIRE)) {
+                    for (int i = 0; i < 8; i++) {
+                        char* value = strukts_lockfree_hashmap_get(dict, reader, keys[i]);
+                        all_found[r] = all_found[r] && value == keys[i];
+                    }
+                }
+
+                strukts_lockfree_hashmap_reader_unregister(dict, reader);
+            }));
+        }
+
+        for (int i = 8; i < keys_amount; i++) {
+            strukts_lockfree_hashmap_upsert(dict, keys[i], keys[i]);
+
+            if (i % 2 == 0 && i > 8)
+                removed += strukts_lockfree_hashmap_remove(dict, keys[i - 1]);
+        }
+
+        __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+
+        for (size_t r = 0; r < readers.size(); r++)
+            readers[r].join();
+
+        /* assert */
+        for (int r = 0; r < readers_amount; r++)
+            EXPECT_TRUE(all_found[r]);
+
+        EXPECT_EQ(strukts_lockfree_hashmap_size(dict), keys_amount - removed);
+        EXPECT_GE(dict->table->capacity, 1024);
+
+        strukts_lockfree_hashmap_free(dict);
+    }
+}  // namespace
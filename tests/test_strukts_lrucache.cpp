@@ -0,0 +1,80 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "strukts_lrucache.h"
+
+namespace
+{
+    TEST(STRUKTS_LRUCACHE_SUITE, SHOULD_EVICT_LEAST_RECENTLY_USED_ENTRIES)
+    {
+        /* arrange */
+        StruktsLRUCache* cache = strukts_lrucache_new(3, 0);
+
+        strukts_lrucache_put(cache, "a", (char*)"1");
+        strukts_lrucache_put(cache, "b", (char*)"2");
+        strukts_lrucache_put(cache, "c", (char*)"3");
+
+        /* act - "a" becomes the most recently used entry, so "b" is evicted */
+        char* value = strukts_lrucache_get(cache, "a");
+        strukts_lrucache_put(cache, "d", (char*)"4");
+
+        /* assert */
+        EXPECT_EQ(strcmp(value, "1"), 0);
+        EXPECT_EQ(strukts_lrucache_size(cache), 3);
+        EXPECT_EQ(cache->evictions, 1);
+        EXPECT_TRUE(strukts_lrucache_get(cache, "b") == NULL);
+        EXPECT_EQ(strcmp(strukts_lrucache_get(cache, "c"), "3"), 0);
+        EXPECT_EQ(strcmp(strukts_lrucache_get(cache, "d"), "4"), 0);
+        EXPECT_EQ(strcmp(cache->recency->first_node->key, "d"), 0);
+        EXPECT_EQ(strcmp(cache->recency->last_node->key, "a"), 0);
+
+        EXPECT_EQ(cache->hits, 3);
+        EXPECT_EQ(cache->misses, 1);
+
+        /* act - replacing a value refreshes its recency without growing the cache */
+        strukts_lrucache_put(cache, "a", (char*)"5");
+        strukts_lrucache_put(cache, "e", (char*)"6");
+
+        /* assert - "c" was the least recently used one */
+        EXPECT_EQ(strukts_lrucache_size(cache), 3);
+        EXPECT_EQ(strcmp(strukts_lrucache_get(cache, "a"), "5"), 0);
+        EXPECT_TRUE(strukts_lrucache_get(cache, "c") == NULL);
+
+        /* act & assert - removals */
+        EXPECT_TRUE(strukts_lrucache_remove(cache, "a"));
+        EXPECT_FALSE(strukts_lrucache_remove(cache, "a"));
+        EXPECT_EQ(strukts_lrucache_size(cache), 2);
+        EXPECT_EQ(cache->index->size, 2);
+
+        strukts_lrucache_free(cache);
+    }
+
+    TEST(STRUKTS_LRUCACHE_SUITE, SHOULD_EVICT_ENTRIES_BY_BYTES)
+    {
+        /* arrange - each entry below takes 2 + 8 = 10 bytes */
+        StruktsLRUCache* cache = strukts_lrucache_new(0, 25);
+
+        /* act */
+        strukts_lrucache_put(cache, "k1", (char*)"value--1");
+        strukts_lrucache_put(cache, "k2", (char*)"value--2");
+        strukts_lrucache_put(cache, "k3", (char*)"value--3");
+
+        /* assert */
+        EXPECT_EQ(strukts_lrucache_size(cache), 2);
+        EXPECT_EQ(cache->bytes, 20);
+        EXPECT_TRUE(strukts_lrucache_get(cache, "k1") == NULL);
+
+        /* act & assert - an entry bigger than the whole cache is rejected */
+        EXPECT_FALSE(strukts_lrucache_put(cache, "huge", (char*)"this value does not fit at all"));
+        EXPECT_EQ(strukts_lrucache_size(cache), 2);
+
+        /* act & assert - a bigger value evicts older entries */
+        EXPECT_TRUE(strukts_lrucache_put(cache, "k3", (char*)"a longer value"));
+        EXPECT_EQ(strukts_lrucache_size(cache), 1);
+        EXPECT_EQ(cache->bytes, 16);
+
+        strukts_lrucache_free(cache);
+    }
+}  // namespace
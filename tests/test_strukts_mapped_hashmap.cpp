@@ -0,0 +1,193 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_hashmap.h"
+#include "strukts_mapped_hashmap.h"
+
+#define MAPPED_HASHMAP_TEST_FILE "strukts_mapped_hashmap_test.bin"
+
+namespace
+{
+    TEST(STRUKTS_MAPPED_HASHMAP_SUITE, SHOULD_SERVE_LOOKUPS_FROM_MAPPED_FILE)
+    {
+        /* arrange - the hash map is in the middle of an incremental rehashing */
+        StruktsHashmap* hashmap =
+            strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_INCREMENTAL_REHASH);
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+
+        for (int i = 0; i < 200; i++) {
+            keys.push_back("key-" + std::to_string(i));
+            values.push_back("value-" + std::to_string(i));
+        }
+
+        for (size_t i = 0; i < keys.size(); i++)
+            strukts_hashmap_add(hashmap, keys[i].c_str(), (char*)values[i].c_str());
+
+        strukts_hashmap_add(hashmap, "key-7", (char*)"newest"); /* shadows the first key-7 */
+        strukts_hashmap_add(hashmap, "null", NULL);
+        strukts_hashmap_add_n(hashmap, "bin\0ary", 7, (char*)"binary");
+
+        /* act */
+        bool written = strukts_mapped_hashmap_write(hashmap, MAPPED_HASHMAP_TEST_FILE);
+        strukts_hashmap_free(hashmap); /* the mapped file doesn't depend on the hash map */
+
+        StruktsMappedHashmap* mapped = strukts_mapped_hashmap_open(MAPPED_HASHMAP_TEST_FILE);
+
+        /* assert */
+        EXPECT_TRUE(written);
+        ASSERT_TRUE(mapped != NULL);
+        EXPECT_EQ(mapped->size, 202);
+        EXPECT_GT(mapped->slots_amount, mapped->size);
+
+        for (size_t i = 0; i < keys.size(); i++) {
+            const char* value = strukts_mapped_hashmap_get(mapped, keys[i].c_str());
+
+            ASSERT_TRUE(value != NULL);
+            EXPECT_EQ(strcmp(value, i == 7 ? "newest" : values[i].c_str()), 0);
+        }
+
+        EXPECT_EQ(strcmp(strukts_mapped_hashmap_get_n(mapped, "bin\0ary", 7), "binary"), 0);
+        EXPECT_TRUE(strukts_mapped_hashmap_get(mapped, "bin") == NULL);
+        EXPECT_TRUE(strukts_mapped_hashmap_get(mapped, "null") == NULL);
+        EXPECT_TRUE(strukts_mapped_hashmap_get(mapped, "missing") == NULL);
+
+        strukts_mapped_hashmap_close(mapped);
+        remove(MAPPED_HASHMAP_TEST_FILE);
+    }
+
+    TEST(STRUKTS_MAPPED_HASHMAP_SUITE, SHOULD_MAP_EMPTY_HASHMAP)
+    {
+        /* arrange */
+        StruktsHashmap* hashmap = strukts_hashmap_new();
+
+        /* act */
+        bool written = strukts_mapped_hashmap_write(hashmap, MAPPED_HASHMAP_TEST_FILE);
+        StruktsMappedHashmap* mapped = strukts_mapped_hashmap_open(MAPPED_HASHMAP_TEST_FILE);
+
+        /* assert */
+        EXPECT_TRUE(written);
+        ASSERT_TRUE(mapped != NULL);
+        EXPECT_EQ(mapped->size, 0);
+        EXPECT_TRUE(strukts_mapped_hashmap_get(mapped, "k1") == NULL);
+
+        strukts_hashmap_free(hashmap);
+        strukts_mapped_hashmap_close(mapped);
+        remove(MAPPED_HASHMAP_TEST_FILE);
+    }
+
+    TEST(STRUKTS_MAPPED_HASHMAP_SUITE, SHOULD_HASH_KEYS_LIKE_THE_SAVED_HASHMAP)
+    {
+        /* arrange */
+        StruktsHashmap* hashmap = strukts_hashmap_new_with_flags(STRUKTS_HASHMAP_MURMUR3_128);
+        std::string long_key(1000, 'k');
+
+        strukts_hashmap_add(hashmap, "k1", (char*)"v1");
+        strukts_hashmap_add(hashmap, long_key.c_str(), (char*)"long");
+
+        /* act */
+        bool written = strukts_mapped_hashmap_write(hashmap, MAPPED_HASHMAP_TEST_FILE);
+        StruktsMappedHashmap* mapped = strukts_mapped_hashmap_open(MAPPED_HASHMAP_TEST_FILE);
+
+        /* assert */
+        EXPECT_TRUE(written);
+        ASSERT_TRUE(mapped != NULL);
+        EXPECT_EQ(mapped->hash_flags, STRUKTS_HASHMAP_MURMUR3_128);
+        EXPECT_STREQ(strukts_mapped_hashmap_get(mapped, "k1"), "v1");
+        EXPECT_STREQ(strukts_mapped_hashmap_get(mapped, long_key.c_str()), "long");
+        EXPECT_TRUE(strukts_mapped_hashmap_get(mapped, "k2") == NULL);
+
+        strukts_hashmap_free(hashmap);
+        strukts_mapped_hashmap_close(mapped);
+        remove(MAPPED_HASHMAP_TEST_FILE);
+    }
+
+    TEST(STRUKTS_MAPPED_HASHMAP_SUITE, SHOULD_REJECT_MISSING_OR_INVALID_FILES)
+    {
+        /* arrange */
+        StruktsHashmap* hashmap = strukts_hashmap_new();
+        std::vector<char> bytes;
+
+        strukts_hashmap_add(hashmap, "k1", (char*)"v1");
+        strukts_mapped_hashmap_write(hashmap, MAPPED_HASHMAP_TEST_FILE);
+
+        FILE* file = fopen(MAPPED_HASHMAP_TEST_FILE, "rb");
+
+        for (int c = fgetc(file); c != EOF; c = fgetc(file))
+            bytes.push_back((char)c);
+
+        fclose(file);
+
+        /* act & assert - missing files */
+        remove(MAPPED_HASHMAP_TEST_FILE);
+        EXPECT_TRUE(strukts_mapped_hashmap_open(MAPPED_HASHMAP_TEST_FILE) == NULL);
+
+        /* act & assert - a wrong magic, a truncated file and a header only file */
+        std::vector<std::vector<char> > corrupted(3, bytes);
+
+        corrupted[0][0] = 'X';
+        corrupted[1].resize(bytes.size() - 1);
+        corrupted[2].resize(sizeof(StruktsMappedHashmapHeader));
+
+        for (size_t i = 0; i < corrupted.size(); i++) {
+            file = fopen(MAPPED_HASHMAP_TEST_FILE, "wb");
+            fwrite(corrupted[i].data(), 1, corrupted[i].size(), file);
+            fclose(file);
+
+            EXPECT_TRUE(strukts_mapped_hashmap_open(MAPPED_HASHMAP_TEST_FILE) == NULL);
+        }
+
+        strukts_hashmap_free(hashmap);
+        remove(MAPPED_HASHMAP_TEST_FILE);
+    }
+
+    TEST(STRUKTS_MAPPED_HASHMAP_SUITE, SHOULD_NOT_READ_PAST_FILE_WITH_CORRUPTED_KEY_OFFSETS)
+    {
+        /* arrange */
+        StruktsHashmap* hashmap = strukts_hashmap_new();
+        std::vector<char> bytes;
+
+        strukts_hashmap_add(hashmap, "k1", (char*)"v1");
+        strukts_mapped_hashmap_write(hashmap, MAPPED_HASHMAP_TEST_FILE);
+
+        FILE* file = fopen(MAPPED_HASHMAP_TEST_FILE, "rb");
+
+        for (int c = fgetc(file); c != EOF; c = fgetc(file))
+            bytes.push_back((char)c);
+
+        fclose(file);
+
+        /* act - key offsets so big that adding the key's length to them wraps around */
+        StruktsMappedHashmapHeader header;
+
+        memcpy(&header, bytes.data(), sizeof(header));
+
+        for (uint64_t i = 0; i < header.slots_amount; i++) {
+            StruktsMappedHashmapSlot* slot =
+                (StruktsMappedHashmapSlot*)(bytes.data() + header.slots_offset) + i;
+
+            if (slot->key_offset != 0)
+                slot->key_offset = UINT64_MAX - 1;
+        }
+
+        file = fopen(MAPPED_HASHMAP_TEST_FILE, "wb");
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+
+        StruktsMappedHashmap* mapped = strukts_mapped_hashmap_open(MAPPED_HASHMAP_TEST_FILE);
+
+        /* assert - the corrupted slot is rejected instead of being compared */
+        ASSERT_TRUE(mapped != NULL);
+        EXPECT_TRUE(strukts_mapped_hashmap_get(mapped, "k1") == NULL);
+
+        strukts_mapped_hashmap_close(mapped);
+        strukts_hashmap_free(hashmap);
+        remove(MAPPED_HASHMAP_TEST_FILE);
+    }
+}  // namespace
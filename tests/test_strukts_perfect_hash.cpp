@@ -0,0 +1,86 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "strukts_perfect_hash.h"
+
+namespace
+{
+    TEST(STRUKTS_PERFECT_HASH_SUITE, SHOULD_MAP_KEYS_TO_DISTINCT_INDEXES_WITH_FEW_BITS_PER_KEY)
+    {
+        /* arrange */
+        std::vector<std::string> keys;
+        std::vector<const char*> key_pointers;
+
+        for (int i = 0; i < 10000; i++)
+            keys.push_back("https://strukts.io/" + std::to_string(i));
+
+        for (size_t i = 0; i < keys.size(); i++)
+            key_pointers.push_back(keys[i].c_str());
+
+        /* act */
+        StruktsPerfectHash* perfect_hash =
+            strukts_perfect_hash_build(key_pointers.data(), key_pointers.size());
+
+        /* assert - the indexes are a permutation of [0, n) */
+        ASSERT_TRUE(perfect_hash != NULL);
+
+        std::vector<bool> used(keys.size(), false);
+
+        for (size_t i = 0; i < keys.size(); i++) {
+            size_t index = strukts_perfect_hash_index(perfect_hash, keys[i].c_str());
+
+            ASSERT_LT(index, keys.size());
+            EXPECT_FALSE(used[index]);
+            used[index] = true;
+        }
+
+        EXPECT_GT(perfect_hash->levels_amount, 1);
+        EXPECT_LT(strukts_perfect_hash_bits_per_key(perfect_hash), 5.0);
+
+        /* keys that are not in the set are mapped to no index or any index */
+        size_t index = strukts_perfect_hash_index(perfect_hash, "missing");
+
+        EXPECT_TRUE(index == STRUKTS_PERFECT_HASH_NOT_FOUND || index < keys.size());
+
+        strukts_perfect_hash_free(perfect_hash);
+    }
+
+    TEST(STRUKTS_PERFECT_HASH_SUITE, SHOULD_HANDLE_EMPTY_AND_SINGLE_KEY_SETS)
+    {
+        /* arrange */
+        const char* keys[1] = {"k1"};
+
+        /* act */
+        StruktsPerfectHash* empty = strukts_perfect_hash_build(keys, 0);
+        StruktsPerfectHash* single = strukts_perfect_hash_build(keys, 1);
+
+        /* assert */
+        ASSERT_TRUE(empty != NULL);
+        ASSERT_TRUE(single != NULL);
+        EXPECT_EQ(strukts_perfect_hash_index(empty, "k1"), STRUKTS_PERFECT_HASH_NOT_FOUND);
+        EXPECT_EQ(strukts_perfect_hash_bits_per_key(empty), 0);
+        EXPECT_EQ(strukts_perfect_hash_index(single, "k1"), 0);
+        EXPECT_EQ(strukts_perfect_hash_index_n(single, "k1-suffix", 2), 0);
+
+        strukts_perfect_hash_free(empty);
+        strukts_perfect_hash_free(single);
+    }
+
+    TEST(STRUKTS_PERFECT_HASH_SUITE, SHOULD_FAIL_TO_BUILD_WITH_DUPLICATE_KEYS)
+    {
+        /* arrange */
+        const char* keys[3] = {"k1", "k2", "k1"};
+
+        /* act */
+        StruktsPerfectHash* perfect_hash = strukts_perfect_hash_build(keys, 3);
+
+        /* assert - duplicate keys collide on every level */
+        EXPECT_TRUE(perfect_hash == NULL);
+    }
+}  // namespace
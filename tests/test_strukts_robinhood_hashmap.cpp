@@ -0,0 +1,82 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "strukts_robinhood_hashmap.h"
+
+namespace
+{
+    TEST(STRUKTS_ROBINHOOD_HASHMAP_SUITE, SHOULD_KEEP_PROBE_LENGTHS_SHORT_AT_HIGH_LOAD_FACTOR)
+    {
+        /* arrange - 921 keys fill 1024 slots up to a 0.9 load factor */
+        const int keys_amount = 921;
+        static char keys[921][16];
+        StruktsRobinHoodHashmap* dict = strukts_robinhood_hashmap_new();
+
+        /* act */
+        for (int i = 0; i < keys_amount; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key-%d", i);
+            strukts_robinhood_hashmap_upsert(dict, keys[i], keys[i]);
+        }
+
+        StruktsRobinHoodHashmapProbeStats stats = strukts_robinhood_hashmap_probe_stats(dict);
+
+        /* assert */
+        EXPECT_EQ(dict->size, keys_amount);
+        EXPECT_EQ(dict->capacity, 1024);
+
+        for (int i = 0; i < keys_amount; i++)
+            EXPECT_EQ(strukts_robinhood_hashmap_get(dict, keys[i]), keys[i]);
+
+        EXPECT_TRUE(strukts_robinhood_hashmap_get(dict, "key-unknown") == NULL);
+        EXPECT_GT(stats.mean_probe_length, 0.0);
+        EXPECT_LT(stats.mean_probe_length, 8.0);
+        EXPECT_LT(stats.max_probe_length, 64);
+
+        strukts_robinhood_hashmap_free(dict);
+    }
+
+    TEST(STRUKTS_ROBINHOOD_HASHMAP_SUITE, SHOULD_REMOVE_KEYS_WITHOUT_TOMBSTONES)
+    {
+        /* arrange */
+        const int keys_amount = 500;
+        static char keys[500][16];
+        StruktsRobinHoodHashmap* dict = strukts_robinhood_hashmap_new();
+
+        for (int i = 0; i < keys_amount; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key-%d", i);
+            strukts_robinhood_hashmap_upsert(dict, keys[i], keys[i]);
+        }
+
+        /* act - removes every even key */
+        for (int i = 0; i < keys_amount; i += 2)
+            EXPECT_TRUE(strukts_robinhood_hashmap_remove(dict, keys[i]));
+
+        /* assert */
+        EXPECT_EQ(dict->size, keys_amount / 2);
+        EXPECT_FALSE(strukts_robinhood_hashmap_remove(dict, keys[0]));
+
+        for (int i = 0; i < keys_amount; i++) {
+            char* expected = i % 2 == 0 ? NULL : keys[i];
+            EXPECT_EQ(strukts_robinhood_hashmap_get(dict, keys[i]), expected);
+        }
+
+        /* act - removes the remaining keys */
+        for (int i = 1; i < keys_amount; i += 2)
+            strukts_robinhood_hashmap_remove(dict, keys[i]);
+
+        /* assert - every slot is empty again: nothing was left behind */
+        size_t full_slots = 0;
+
+        for (size_t i = 0; i < dict->capacity; i++)
+            full_slots += dict->slots[i].distance != 0;
+
+        EXPECT_EQ(dict->size, 0);
+        EXPECT_EQ(full_slots, 0);
+        EXPECT_EQ(strukts_robinhood_hashmap_probe_stats(dict).max_probe_length, 0);
+
+        strukts_robinhood_hashmap_free(dict);
+    }
+}  // namespace